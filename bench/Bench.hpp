@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+namespace stl::bench {
+
+// Calls the function until at least minSeconds have passed and returns the average seconds per call
+template<typename Function>
+double measure(Function&& function, double minSeconds = 0.25) {
+	using Clock = std::chrono::steady_clock;
+
+	// the first call warms up caches and allocations
+	function();
+
+	uint64_t calls = 0;
+	auto start = Clock::now();
+	double elapsed = 0.0;
+
+	do {
+		function();
+		calls++;
+		elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	} while (elapsed < minSeconds);
+
+	return elapsed / calls;
+}
+
+// One line per measurement, items is whatever a call processes (objects, lights, matrices)
+inline void report(const char* name, double seconds, double items = 0.0) {
+	if (items > 0.0) {
+		std::printf("%-48s %10.3f ms %12.2f M/s\n", name, seconds * 1e3, items / seconds * 1e-6);
+	} else {
+		std::printf("%-48s %10.3f ms\n", name, seconds * 1e3);
+	}
+}
+
+// Keeps the compiler from dropping results that are never read
+template<typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const void* volatile sink;
+	sink = &value;
+#endif
+}
+
+}
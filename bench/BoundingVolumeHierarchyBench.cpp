@@ -0,0 +1,122 @@
+#include "Bench.hpp"
+
+#include "renderer/BoundingVolumeHierarchy.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr uint32_t SPHERE_COUNT = 100;
+constexpr uint32_t RAY_COUNT = 1000;
+
+}
+
+// Build, refit and query times for 10k to 1M boxes spread through a world that grows with their count. The frustum
+// spans the whole world and sees a constant fraction of the items, spheres and rays touch about the same number.
+int main() {
+	for (size_t count : { 10000, 100000, 1000000 }) {
+		std::mt19937 rng{ 3 };
+
+		float worldSize = std::cbrt(static_cast<float>(count)) * 4.0f;
+		std::uniform_real_distribution<float> position{ -worldSize, worldSize };
+		std::uniform_real_distribution<float> extent{ 0.1f, 1.0f };
+		std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+
+		std::vector<Aabb> items(count);
+
+		for (Aabb& item : items) {
+			glm::vec3 center{ position(rng), position(rng), position(rng) };
+			glm::vec3 halfSize{ extent(rng), extent(rng), extent(rng) };
+			item = Aabb{ center - halfSize, center + halfSize };
+		}
+
+		std::string name = std::to_string(count) + " items, ";
+		BoundingVolumeHierarchy bvh;
+
+		double seconds = bench::measure([&] { bvh.build(items); });
+		bench::report((name + "build").c_str(), seconds, static_cast<double>(count));
+
+		// the moved items go back and forth so the tree does not degrade over the calls
+		for (size_t divisor : { 100, 10 }) {
+			std::vector<uint32_t> moved;
+
+			for (size_t i = 0; i < count / divisor; i++) {
+				moved.push_back(static_cast<uint32_t>(rng() % count));
+			}
+
+			float offset = 0.5f;
+
+			seconds = bench::measure([&] {
+				for (uint32_t item : moved) {
+					items[item].min.x += offset;
+					items[item].max.x += offset;
+					bvh.update(item, items[item]);
+				}
+
+				bvh.refit();
+				offset = -offset;
+			});
+
+			bench::report((name + "refit, " + std::to_string(100 / divisor) + "% moved").c_str(), seconds, static_cast<double>(moved.size()));
+		}
+
+		glm::mat4 projection = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, worldSize);
+		glm::mat4 view = glm::lookAt(glm::vec3{ 0.0f, 0.0f, -worldSize }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+		Frustum frustum{ projection * view };
+
+		std::vector<uint32_t> result;
+
+		seconds = bench::measure([&] {
+			result.clear();
+			bvh.queryFrustum(frustum, result);
+		});
+
+		bench::report((name + "frustum query, " + std::to_string(result.size()) + " visible").c_str(), seconds);
+
+		std::vector<glm::vec3> centers;
+
+		for (uint32_t i = 0; i < SPHERE_COUNT; i++) {
+			centers.push_back({ position(rng), position(rng), position(rng) });
+		}
+
+		seconds = bench::measure([&] {
+			result.clear();
+
+			for (const glm::vec3& center : centers) {
+				bvh.querySphere(center, 10.0f, result);
+			}
+		});
+
+		bench::report((name + "sphere queries, radius 10").c_str(), seconds, SPHERE_COUNT);
+
+		std::vector<glm::vec3> origins;
+		std::vector<glm::vec3> directions;
+
+		for (uint32_t i = 0; i < RAY_COUNT; i++) {
+			origins.push_back({ position(rng), position(rng), position(rng) });
+			directions.push_back({ unit(rng), unit(rng), unit(rng) });
+		}
+
+		seconds = bench::measure([&] {
+			uint32_t hits = 0;
+
+			for (uint32_t i = 0; i < RAY_COUNT; i++) {
+				hits += bvh.raycast(origins[i], directions[i], std::numeric_limits<float>::infinity()).has_value();
+			}
+
+			bench::doNotOptimize(hits);
+		});
+
+		bench::report((name + "raycasts").c_str(), seconds, RAY_COUNT);
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+#include "Bench.hpp"
+
+#include "Scene.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+// layout of the objects before they were split into component stores, one map entry owns all components
+struct MapObject {
+	TransformComponent transform{};
+	std::shared_ptr<Model> model{};
+	glm::vec3 color{};
+	std::unique_ptr<PointLightComponent> pointLight{};
+};
+
+using ObjectMap = std::unordered_map<GameObject::id_t, MapObject>;
+
+void runBenchmarks(uint32_t objectCount) {
+	Scene scene;
+	ObjectMap objects;
+	std::vector<GameObject::id_t> ids;
+
+	// every tenth object is a light, like a scene of props with a few lamps
+	for (uint32_t i = 0; i < objectCount; i++) {
+		glm::vec3 translation{ static_cast<float>(i), 0.0f, 0.0f };
+
+		GameObject object = i % 10 == 0 ? scene.createPointLight() : scene.createGameObject();
+		object.getTransform().setTranslation(translation);
+		ids.push_back(object.getId());
+
+		MapObject& mapObject = objects[object.getId()];
+		mapObject.transform.setTranslation(translation);
+
+		if (i % 10 == 0) {
+			mapObject.pointLight = std::make_unique<PointLightComponent>();
+		}
+	}
+
+	std::string count = std::to_string(objectCount) + " objects, ";
+	double lightCount = static_cast<double>(scene.getPointLights().size());
+
+	double seconds = bench::measure([&] {
+		float intensity = 0.0f;
+
+		for (const auto& [id, object] : objects) {
+			if (object.pointLight) intensity += object.pointLight->lightIntensity * object.transform.getTranslation().x;
+		}
+
+		bench::doNotOptimize(intensity);
+	});
+	bench::report((count + "lights, map").c_str(), seconds, lightCount);
+
+	seconds = bench::measure([&] {
+		float intensity = 0.0f;
+		const auto& lights = scene.getPointLights();
+		const auto& transforms = scene.getTransforms();
+
+		for (size_t i = 0; i < lights.size(); i++) {
+			intensity += lights[i].lightIntensity * transforms.get(lights.getId(i)).getTranslation().x;
+		}
+
+		bench::doNotOptimize(intensity);
+	});
+	bench::report((count + "lights, store").c_str(), seconds, lightCount);
+
+	seconds = bench::measure([&] {
+		glm::vec3 sum{ 0.0f };
+
+		for (const auto& [id, object] : objects) {
+			sum += object.transform.getTranslation();
+		}
+
+		bench::doNotOptimize(sum);
+	});
+	bench::report((count + "transforms, map").c_str(), seconds, objectCount);
+
+	seconds = bench::measure([&] {
+		glm::vec3 sum{ 0.0f };
+
+		for (const TransformComponent& transform : scene.getTransforms()) {
+			sum += transform.getTranslation();
+		}
+
+		bench::doNotOptimize(sum);
+	});
+	bench::report((count + "transforms, store").c_str(), seconds, objectCount);
+
+	// random lookups, the way render systems resolve the visible ids
+	std::vector<GameObject::id_t> lookups = ids;
+	std::shuffle(lookups.begin(), lookups.end(), std::mt19937{ 1 });
+
+	seconds = bench::measure([&] {
+		glm::vec3 sum{ 0.0f };
+
+		for (GameObject::id_t id : lookups) {
+			sum += objects.find(id)->second.transform.getTranslation();
+		}
+
+		bench::doNotOptimize(sum);
+	});
+	bench::report((count + "lookups, map").c_str(), seconds, objectCount);
+
+	seconds = bench::measure([&] {
+		glm::vec3 sum{ 0.0f };
+		const auto& transforms = scene.getTransforms();
+
+		for (GameObject::id_t id : lookups) {
+			sum += transforms.get(id).getTranslation();
+		}
+
+		bench::doNotOptimize(sum);
+	});
+	bench::report((count + "lookups, store").c_str(), seconds, objectCount);
+}
+
+}
+
+// Iteration and lookups of the component stores compared to one unordered_map holding whole objects
+int main() {
+	for (uint32_t objectCount : { 10000, 100000 }) {
+		runBenchmarks(objectCount);
+	}
+
+	return 0;
+}
@@ -0,0 +1,45 @@
+#include "Bench.hpp"
+
+#include "renderer/CullingKernel.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+// Spheres per second of every path the cpu supports, for sphere counts from cache resident to memory bound
+int main() {
+	glm::mat4 projection = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3{ 0.0f, 0.0f, -50.0f }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+	Frustum frustum{ projection * view };
+
+	std::mt19937 rng{ 1 };
+	std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+	std::uniform_real_distribution<float> radius{ 0.1f, 2.0f };
+
+	for (size_t count : { 1000, 10000, 100000, 1000000 }) {
+		SphereArrays spheres;
+
+		for (size_t i = 0; i < count; i++) {
+			spheres.push({ position(rng), position(rng), position(rng) }, radius(rng));
+		}
+
+		std::vector<uint8_t> visibility(count);
+
+		for (CullingKernel::Path path : { CullingKernel::Path::Scalar, CullingKernel::Path::SSE, CullingKernel::Path::AVX2 }) {
+			if (!CullingKernel::isSupported(path)) continue;
+
+			double seconds = bench::measure([&] {
+				bench::doNotOptimize(CullingKernel::cullSpheres(frustum, spheres, visibility.data(), path));
+			});
+
+			std::string name = std::to_string(count) + " spheres, " + CullingKernel::getPathName(path);
+			bench::report(name.c_str(), seconds, static_cast<double>(count));
+		}
+	}
+
+	return 0;
+}
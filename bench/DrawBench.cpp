@@ -0,0 +1,229 @@
+#include "Bench.hpp"
+#include "DeviceFixture.hpp"
+
+#include "renderer/rendersystems/SimpleRenderSystem.hpp"
+#include "renderer/rendersystems/PointLightSystem.hpp"
+#include "renderer/FrameUniforms.hpp"
+#include "renderer/FrustumCuller.hpp"
+#include "renderer/GeometryPool.hpp"
+#include "renderer/Renderer.hpp"
+#include "Scene.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr uint32_t GRID_SIZE = 100;
+// 160k objects, their data spans several binding ranges and outgrows the default frame size
+constexpr uint32_t LARGE_GRID_SIZE = 400;
+constexpr uint32_t FRAME_COUNT = 200;
+
+Model::Data createCube() {
+	Model::Data data{};
+
+	for (int i = 0; i < 8; i++) {
+		glm::vec3 position{ i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f };
+		data.vertices.push_back({ position, { 0.8f, 0.8f, 0.8f }, glm::normalize(position) });
+	}
+
+	data.indices = {
+		0, 2, 1, 1, 2, 3,  4, 5, 6, 5, 7, 6,
+		0, 1, 4, 1, 5, 4,  2, 6, 3, 3, 6, 7,
+		0, 4, 2, 2, 4, 6,  1, 3, 5, 3, 7, 5
+	};
+
+	data.computeBounds();
+	return data;
+}
+
+// A grid of cubes facing the camera, either all sharing the first model or each with its own
+void createObjects(Scene& scene, const std::vector<std::shared_ptr<Model>>& models, bool shared) {
+	for (uint32_t x = 0; x < GRID_SIZE; x++) {
+		for (uint32_t y = 0; y < GRID_SIZE; y++) {
+			GameObject object = scene.createGameObject();
+			object.setModel(models[shared ? 0 : x * GRID_SIZE + y]);
+			object.getTransform().setTranslation({ x - GRID_SIZE * 0.5f, y - GRID_SIZE * 0.5f, 0.0f });
+			object.getTransform().setScale(glm::vec3{ 0.5f });
+		}
+	}
+
+	scene.createPointLight(1.0f, 0.1f, { 1.0f, 1.0f, 1.0f }, 50.0f).getTransform().setTranslation({ 0.0f, 0.0f, -20.0f });
+}
+
+// The same area as the other grids filled with smaller cubes of one shared model
+void createLargeGrid(Scene& scene, const std::shared_ptr<Model>& model) {
+	float spacing = static_cast<float>(GRID_SIZE) / LARGE_GRID_SIZE;
+
+	for (uint32_t x = 0; x < LARGE_GRID_SIZE; x++) {
+		for (uint32_t y = 0; y < LARGE_GRID_SIZE; y++) {
+			GameObject object = scene.createGameObject();
+			object.setModel(model);
+			object.getTransform().setTranslation({ x * spacing - GRID_SIZE * 0.5f, y * spacing - GRID_SIZE * 0.5f, 0.0f });
+			object.getTransform().setScale(glm::vec3{ spacing * 0.5f });
+		}
+	}
+
+	scene.createPointLight(1.0f, 0.1f, { 1.0f, 1.0f, 1.0f }, 50.0f).getTransform().setTranslation({ 0.0f, 0.0f, -20.0f });
+}
+
+}
+
+// Records and submits 10k cubes that are all in view. Every cube has its own model, so nothing is instanced and the
+// direct path records one draw per object while the indirect path records a single draw. The same grid with one
+// shared model shows what instancing leaves of the recording cost, and a grid of 160k shared cubes is drawn in
+// chunks of one binding range each.
+int main() {
+	auto fixture = test::DeviceFixture::create();
+
+	if (!fixture) {
+		return test::SKIPPED;
+	}
+
+	Device& device = *fixture->device;
+	Renderer renderer{ *fixture->window, device };
+	GeometryPool geometryPool{ device };
+
+	Model::Data cube = createCube();
+	TransferContext& transfer = geometryPool.getTransferContext();
+	std::vector<std::shared_ptr<Model>> models;
+
+	// all uploads go into one batch instead of waiting for every model on its own
+	for (uint32_t i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+		models.push_back(std::make_shared<Model>(geometryPool, cube, transfer));
+	}
+
+	transfer.wait(transfer.getRecordingTicket());
+
+	Scene uniqueScene;
+	Scene sharedScene;
+	createObjects(uniqueScene, models, false);
+	createObjects(sharedScene, models, true);
+
+	Scene largeScene;
+	createLargeGrid(largeScene, models[0]);
+
+	auto globalPool = DescriptorPool::Builder(device)
+		.setMaxSets(Swapchain::MAX_FRAMES_IN_FLIGHT)
+		.addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, Swapchain::MAX_FRAMES_IN_FLIGHT)
+		.build();
+
+	auto globalSetLayout = DescriptorSetLayout::Builder(device)
+		.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.build();
+
+	FrameUniforms frameUniforms{ device };
+	std::vector<VkDescriptorSet> globalDescriptorSets(Swapchain::MAX_FRAMES_IN_FLIGHT);
+
+	for (int i = 0; i < globalDescriptorSets.size(); i++) {
+		auto bufferInfo = frameUniforms.descriptorInfo(i);
+
+		DescriptorWriter(*globalSetLayout, *globalPool)
+			.writeBuffer(0, &bufferInfo)
+			.build(globalDescriptorSets[i]);
+	}
+
+	FrameAllocator frameAllocator{ device };
+	PointLightSystem pointLightSystem{ device, renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout(), frameAllocator };
+	SimpleRenderSystem simpleRenderSystem{ device, renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout(), pointLightSystem.getLightSetLayout(), frameAllocator };
+
+	Camera camera{};
+	camera.setViewTarget({ 0.0f, 0.0f, -90.0f }, { 0.0f, 0.0f, 0.0f });
+	camera.setPerspectiveProjection(glm::radians(60.0f), renderer.getAspectRatio(), 0.1f, 200.0f);
+
+	std::printf("%u objects, %s\n", GRID_SIZE * GRID_SIZE, device.p_Features.multiDrawIndirect ? "multi draw indirect" : "one indirect draw per command");
+
+	struct Case {
+		const char* name;
+		Scene& scene;
+		bool indirect;
+	};
+
+	Case cases[] = {
+		{ "unique models, indirect", uniqueScene, true },
+		{ "unique models, direct", uniqueScene, false },
+		{ "shared model, indirect", sharedScene, true },
+		{ "shared model, direct", sharedScene, false },
+		{ "160k objects, shared model, indirect", largeScene, true }
+	};
+
+	for (const Case& test : cases) {
+		Scene& scene = test.scene;
+		FrustumCuller frustumCuller{};
+		simpleRenderSystem.setIndirectEnabled(test.indirect);
+
+		if (test.indirect && !simpleRenderSystem.isIndirectEnabled()) {
+			std::printf("%s: indirect drawing is not supported\n", test.name);
+			continue;
+		}
+
+		double recordSeconds = 0.0;
+		auto start = std::chrono::steady_clock::now();
+		uint32_t frames = 0;
+
+		while (frames < FRAME_COUNT) {
+			glfwPollEvents();
+
+			VkCommandBuffer commandBuffer = renderer.beginFrame();
+
+			if (!commandBuffer) {
+				continue;
+			}
+
+			scene.updateTransforms();
+			frustumCuller.cull(camera, scene);
+
+			int frameIndex = renderer.getFrameIndex();
+			frameAllocator.beginFrame(frameIndex);
+			geometryPool.beginFrame(frameIndex);
+
+			FrameInfo frameInfo{
+				frameIndex,
+				0.0f,
+				commandBuffer,
+				renderer.getSwapchainExtent(),
+				camera,
+				globalDescriptorSets[frameIndex],
+				pointLightSystem.getLightDescriptorSet(frameIndex),
+				scene,
+				frustumCuller.getVisibleObjects(),
+				frustumCuller.getVisibleLights()
+			};
+
+			GlobalUbo ubo{};
+			ubo.projection = camera.getProjection();
+			ubo.view = camera.getView();
+			ubo.inverseView = camera.getInverseView();
+			pointLightSystem.update(frameInfo, ubo);
+			frameUniforms.update(frameIndex, ubo);
+
+			renderer.beginSwapchainRenderPass(commandBuffer);
+
+			auto recordStart = std::chrono::steady_clock::now();
+			simpleRenderSystem.renderGameObjects(frameInfo);
+			recordSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - recordStart).count();
+
+			pointLightSystem.render(frameInfo);
+			renderer.endSwapchainRenderPass(commandBuffer);
+
+			frameAllocator.flush();
+			renderer.endFrame();
+
+			frames++;
+		}
+
+		double frameSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / frames;
+		double objects = static_cast<double>(frustumCuller.getVisibleObjects().size());
+
+		bench::report((std::string{ "record, " } + test.name).c_str(), recordSeconds / frames, objects);
+		bench::report((std::string{ "frame, " } + test.name).c_str(), frameSeconds, objects);
+	}
+
+	vkDeviceWaitIdle(device.getDevice());
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include "Bench.hpp"
+
+#include "renderer/LightClusters.hpp"
+#include "Camera.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+// Light assignment for 100 to 100k lights on grids of increasing resolution, with the scalar kernel, the widest kernel
+// the cpu supports and the widest kernel spread over the thread pool
+int main() {
+	Camera camera{};
+	camera.setPerspectiveProjection(glm::radians(50.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+
+	std::printf("kernel %s\n", ClusterKernel::getPathName(ClusterKernel::getBestPath()));
+
+	for (glm::uvec3 gridSize : { glm::uvec3{ 16, 9, 24 }, glm::uvec3{ 32, 18, 48 }, glm::uvec3{ 64, 36, 64 } }) {
+		LightClusters clusters{ gridSize };
+		clusters.setProjection(camera.getProjection());
+
+		std::string grid = std::to_string(gridSize.x) + "x" + std::to_string(gridSize.y) + "x" + std::to_string(gridSize.z) + ", ";
+
+		for (uint32_t lightCount : { 100, 1000, 10000, 100000 }) {
+			std::mt19937 rng{ lightCount };
+			std::uniform_real_distribution<float> value{ -1.0f, 1.0f };
+			std::vector<glm::vec4> lights;
+
+			for (uint32_t i = 0; i < lightCount; i++) {
+				lights.push_back({ value(rng) * 40.0f, value(rng) * 25.0f, -50.0f + value(rng) * 52.0f, 0.3f + 2.0f * (value(rng) + 1.0f) });
+			}
+
+			std::string name = grid + std::to_string(lightCount) + " lights, ";
+
+			double seconds = bench::measure([&] { clusters.build(lights, ClusterKernel::Path::Scalar, false); });
+			bench::report((name + "scalar").c_str(), seconds, lightCount);
+
+			seconds = bench::measure([&] { clusters.build(lights, ClusterKernel::getBestPath(), false); });
+			bench::report((name + "simd").c_str(), seconds, lightCount);
+
+			seconds = bench::measure([&] { clusters.build(lights, ClusterKernel::getBestPath(), true); });
+			bench::report((name + "simd, threads").c_str(), seconds, lightCount);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include "Bench.hpp"
+
+#include "GameObject.hpp"
+#include "Rotation.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr size_t TRANSFORM_COUNT = 100000;
+
+}
+
+// Cost of building matrices from YXZ euler angles and from quaternions, once for the bare rotation and once for the
+// cached model and normal matrices of a transform
+int main() {
+	std::mt19937 rng{ 3 };
+	std::uniform_real_distribution<float> angle{ -glm::pi<float>(), glm::pi<float>() };
+
+	std::vector<glm::vec3> rotations(TRANSFORM_COUNT);
+	std::vector<glm::quat> orientations(TRANSFORM_COUNT);
+
+	for (size_t i = 0; i < TRANSFORM_COUNT; i++) {
+		rotations[i] = { angle(rng), angle(rng), angle(rng) };
+		orientations[i] = Rotation::fromEulerYXZ(rotations[i]);
+	}
+
+	std::vector<glm::mat3> matrices(TRANSFORM_COUNT);
+
+	double seconds = bench::measure([&] {
+		for (size_t i = 0; i < TRANSFORM_COUNT; i++) {
+			matrices[i] = Rotation::toMatrixYXZ(rotations[i]);
+		}
+
+		bench::doNotOptimize(matrices.back());
+	});
+	bench::report("rotation matrix, euler", seconds, TRANSFORM_COUNT);
+
+	seconds = bench::measure([&] {
+		for (size_t i = 0; i < TRANSFORM_COUNT; i++) {
+			matrices[i] = glm::mat3_cast(orientations[i]);
+		}
+
+		bench::doNotOptimize(matrices.back());
+	});
+	bench::report("rotation matrix, quaternion", seconds, TRANSFORM_COUNT);
+
+	// every call sets a new rotation, so the cached matrices are recomputed each time
+	std::vector<TransformComponent> transforms(TRANSFORM_COUNT);
+	bool flip = false;
+
+	seconds = bench::measure([&] {
+		flip = !flip;
+
+		for (size_t i = 0; i < TRANSFORM_COUNT; i++) {
+			transforms[i].setRotation(flip ? rotations[i] : -rotations[i]);
+			transforms[i].updateMatrices();
+		}
+
+		bench::doNotOptimize(transforms.back().getModelMatrix());
+	});
+	bench::report("transform matrices, euler", seconds, TRANSFORM_COUNT);
+
+	seconds = bench::measure([&] {
+		flip = !flip;
+
+		for (size_t i = 0; i < TRANSFORM_COUNT; i++) {
+			transforms[i].setOrientation(flip ? orientations[i] : glm::conjugate(orientations[i]));
+			transforms[i].updateMatrices();
+		}
+
+		bench::doNotOptimize(transforms.back().getModelMatrix());
+	});
+	bench::report("transform matrices, quaternion", seconds, TRANSFORM_COUNT);
+
+	return 0;
+}
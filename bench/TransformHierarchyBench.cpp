@@ -0,0 +1,122 @@
+#include "Bench.hpp"
+
+#include "Scene.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr uint32_t NODE_COUNT = 100000;
+constexpr uint32_t ROOT_COUNT = 1000;
+
+}
+
+// Full and partial world matrix updates of 100k objects in 1000 random trees
+int main() {
+	std::mt19937 rng{ 9 };
+	std::uniform_real_distribution<float> value{ -1.0f, 1.0f };
+
+	Scene scene;
+	std::vector<GameObject::id_t> ids;
+
+	for (uint32_t i = 0; i < NODE_COUNT; i++) {
+		GameObject object = scene.createGameObject();
+		object.getTransform().setTranslation({ value(rng), value(rng), value(rng) });
+		object.getTransform().setRotation({ value(rng), value(rng), value(rng) });
+
+		// parents are picked from the later part of the earlier objects, which gives trees of moderate depth
+		if (i >= ROOT_COUNT) {
+			scene.setParent(object.getId(), ids[i / 4 + rng() % (i - i / 4)]);
+		}
+
+		ids.push_back(object.getId());
+	}
+
+	scene.updateTransforms();
+
+	auto& transforms = scene.getTransforms();
+	float offset = 0.0f;
+
+	// a structural change reorders the store and recomputes every object
+	GameObject::id_t leaf = ids.back();
+	GameObject::id_t leafParent = *scene.getParent(leaf);
+	bool attached = true;
+
+	double seconds = bench::measure([&] {
+		if (attached) scene.removeParent(leaf); else scene.setParent(leaf, leafParent);
+		attached = !attached;
+
+		bench::doNotOptimize(scene.updateTransforms());
+	});
+	bench::report("reorder and update all", seconds, NODE_COUNT);
+
+	seconds = bench::measure([&] {
+		offset += 1e-3f;
+
+		for (TransformComponent& transform : transforms) {
+			transform.setTranslation(glm::vec3{ offset });
+		}
+	});
+	bench::report("mark all changed", seconds, NODE_COUNT);
+
+	seconds = bench::measure([&] {
+		offset += 1e-3f;
+
+		for (TransformComponent& transform : transforms) {
+			transform.setTranslation(glm::vec3{ offset });
+		}
+
+		bench::doNotOptimize(scene.updateTransforms());
+	});
+	bench::report("mark all changed and update", seconds, NODE_COUNT);
+
+	// the way world matrices were computed before the hierarchy, every object walks up to its root
+	std::vector<glm::mat4> worldMatrices(NODE_COUNT);
+
+	seconds = bench::measure([&] {
+		for (uint32_t i = 0; i < NODE_COUNT; i++) {
+			glm::mat4 world = transforms.get(ids[i]).getModelMatrix();
+
+			for (auto parent = scene.getParent(ids[i]); parent; parent = scene.getParent(*parent)) {
+				world = transforms.get(*parent).getModelMatrix() * world;
+			}
+
+			worldMatrices[i] = world;
+		}
+
+		bench::doNotOptimize(worldMatrices.back());
+	});
+	bench::report("parent walk for all, no caching", seconds, NODE_COUNT);
+
+	std::vector<GameObject::id_t> moved(100);
+
+	seconds = bench::measure([&] {
+		offset += 1e-3f;
+
+		for (GameObject::id_t& id : moved) {
+			id = ids[rng() % NODE_COUNT];
+			transforms.get(id).setTranslation(glm::vec3{ offset });
+		}
+
+		bench::doNotOptimize(scene.updateTransforms());
+	});
+	bench::report("100 random objects changed", seconds);
+
+	seconds = bench::measure([&] {
+		offset += 1e-3f;
+		transforms.get(ids[rng() % ROOT_COUNT]).setTranslation(glm::vec3{ offset });
+
+		bench::doNotOptimize(scene.updateTransforms());
+	});
+	bench::report("one root changed", seconds);
+
+	seconds = bench::measure([&] {
+		bench::doNotOptimize(scene.updateTransforms());
+	});
+	bench::report("nothing changed", seconds);
+
+	return 0;
+}
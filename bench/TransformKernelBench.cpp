@@ -0,0 +1,70 @@
+#include "Bench.hpp"
+
+#include "TransformKernel.hpp"
+#include "GameObject.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+// Matrices per second of every supported path, next to updating the cached matrices of the components one by one
+int main() {
+	std::mt19937 rng{ 1 };
+	std::uniform_real_distribution<float> translation{ -100.0f, 100.0f };
+	std::uniform_real_distribution<float> angle{ -glm::pi<float>(), glm::pi<float>() };
+	std::uniform_real_distribution<float> scale{ 0.5f, 2.0f };
+
+	for (size_t count : { 1000, 100000 }) {
+		TransformArrays arrays;
+		std::vector<TransformComponent> components(count);
+
+		for (size_t i = 0; i < count; i++) {
+			glm::vec3 t{ translation(rng), translation(rng), translation(rng) };
+			glm::vec3 r{ angle(rng), angle(rng), angle(rng) };
+			glm::vec3 s{ scale(rng), scale(rng), scale(rng) };
+
+			arrays.push(t, r, s);
+			components[i].setTranslation(t);
+			components[i].setRotation(r);
+			components[i].setScale(s);
+		}
+
+		std::vector<glm::mat4> modelMatrices(count);
+		std::vector<glm::mat3> normalMatrices(count);
+
+		// every call changes the rotation, so the cached matrices have to be recomputed
+		float offset = 0.0f;
+
+		double seconds = bench::measure([&] {
+			offset += 1e-3f;
+
+			for (TransformComponent& component : components) {
+				component.setRotation(component.getRotation() + offset);
+				component.updateMatrices();
+			}
+
+			bench::doNotOptimize(components.back().getModelMatrix());
+		});
+
+		std::string name = std::to_string(count) + " transforms, component";
+		bench::report(name.c_str(), seconds, static_cast<double>(count));
+
+		for (TransformKernel::Path path : { TransformKernel::Path::Scalar, TransformKernel::Path::SSE, TransformKernel::Path::AVX2 }) {
+			if (!TransformKernel::isSupported(path)) continue;
+
+			seconds = bench::measure([&] {
+				TransformKernel::computeMatrices(arrays, modelMatrices.data(), normalMatrices.data(), path);
+				bench::doNotOptimize(modelMatrices.back());
+			});
+
+			name = std::to_string(count) + " transforms, " + TransformKernel::getPathName(path);
+			bench::report(name.c_str(), seconds, static_cast<double>(count));
+		}
+	}
+
+	return 0;
+}
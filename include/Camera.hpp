@@ -3,6 +3,7 @@
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace stl {
 
@@ -14,12 +15,17 @@ public:
 	void setViewDirection(const glm::vec3& position, const glm::vec3& direction, const glm::vec3& up = { 0.0f, 1.0f, 0.0f });
 	void setViewTarget(const glm::vec3& position, const glm::vec3& target, const glm::vec3& up = { 0.0f, 1.0f, 0.0f });
 	void setViewYXZ(const glm::vec3& position, const glm::vec3& rotation);
+	void setViewRotation(const glm::vec3& position, const glm::quat& orientation);
 
 	const glm::mat4& getProjection() const { return m_ProjectionMatrix; }
 	const glm::mat4& getView() const { return m_ViewMatrix; }
 	const glm::mat4& getInverseView() const { return m_InverseViewMatrix; }
 	const glm::vec3& getPosition() const { return m_Position; }
 
+private:
+	// u, v and w are the x, y and z axes of the camera in world space
+	void setViewBasis(const glm::vec3& position, const glm::vec3& u, const glm::vec3& v, const glm::vec3& w);
+
 private:
 	glm::vec3 m_Position{ 1.0f };
 
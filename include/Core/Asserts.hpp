@@ -23,5 +23,6 @@
 #else
 
 #define SASSERT(expr, ...)
+#define SASSERT_MSG(expr, ...)
 
 #endif
\ No newline at end of file
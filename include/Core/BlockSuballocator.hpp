@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace stl {
+
+// Best-fit suballocation of the range [0, size) with coalescing of neighboring free ranges.
+// Only does the bookkeeping, so it can back any kind of memory or buffer.
+class BlockSuballocator {
+public:
+	BlockSuballocator(uint64_t size);
+
+	std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment = 1);
+	void free(uint64_t offset, uint64_t size);
+
+	uint64_t getSize() const { return m_Size; }
+	uint64_t getUsedSize() const { return m_Size - m_FreeSize; }
+	uint64_t getFreeSize() const { return m_FreeSize; }
+	uint64_t getLargestFreeRange() const;
+	size_t getFreeRangeCount() const { return m_FreeByOffset.size(); }
+	bool isEmpty() const { return m_FreeSize == m_Size; }
+
+private:
+	void insertFreeRange(uint64_t offset, uint64_t size);
+	void eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it);
+
+private:
+	uint64_t m_Size;
+	uint64_t m_FreeSize;
+
+	std::map<uint64_t, uint64_t> m_FreeByOffset;
+	std::multimap<uint64_t, uint64_t> m_FreeBySize;
+};
+
+}
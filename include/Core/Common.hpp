@@ -10,6 +10,9 @@ namespace Common {
 
 	std::vector<char> readFile(const std::string& filepath);
 
+	// Checks cpuid and whether the os saves the ymm registers, always false on non x86 targets
+	bool cpuSupportsAVX2();
+
 	template <typename T, typename... Rest>
 	void hashCombine(size_t& seed, const T& v, const Rest&... rest) {
 		seed ^= std::hash<T>{}(v)+0x9e3779b9 + (seed << 6) + (seed >> 2);
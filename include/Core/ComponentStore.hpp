@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Core/Asserts.hpp"
+#include "Core/IdAllocator.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+// Sparse set of components: the components are packed into one array in no particular order, a paged sparse array
+// maps the index part of an id to their position. Adding, removing and looking up are O(1), removing moves the last
+// component into the gap. Lookups compare the full id, so ids of an older generation are never found.
+template<typename T>
+class ComponentStore {
+public:
+	using id_t = IdAllocator::id_t;
+
+public:
+	ComponentStore() = default;
+
+	ComponentStore(const ComponentStore&) = delete;
+	ComponentStore& operator=(const ComponentStore&) = delete;
+
+	// Replaces the component if the id already has one
+	template<typename... Args>
+	T& add(id_t id, Args&&... args) {
+		uint32_t& index = sparseEntry(id);
+		m_Version++;
+
+		if (index != INVALID_INDEX) {
+			SASSERT_MSG(m_Ids[index] == id, "Component store still holds a component of an older generation of this id!");
+
+			m_Components[index] = T{ std::forward<Args>(args)... };
+			m_Ids[index] = id;
+			return m_Components[index];
+		}
+
+		index = static_cast<uint32_t>(m_Components.size());
+		m_Components.push_back(T{ std::forward<Args>(args)... });
+		m_Ids.push_back(id);
+
+		return m_Components.back();
+	}
+
+	void remove(id_t id) {
+		if (!contains(id)) return;
+
+		uint32_t index = lookup(id);
+		uint32_t lastIndex = static_cast<uint32_t>(m_Components.size() - 1);
+
+		if (index != lastIndex) {
+			id_t lastId = m_Ids[lastIndex];
+
+			m_Components[index] = std::move(m_Components[lastIndex]);
+			m_Ids[index] = lastId;
+			sparseEntry(lastId) = index;
+		}
+
+		m_Components.pop_back();
+		m_Ids.pop_back();
+		sparseEntry(id) = INVALID_INDEX;
+		m_Version++;
+	}
+
+	void clear() {
+		m_Components.clear();
+		m_Ids.clear();
+		m_Pages.clear();
+		m_Version++;
+	}
+
+	bool contains(id_t id) const { return lookup(id) != INVALID_INDEX; }
+
+	T& get(id_t id) {
+		SASSERT_MSG(contains(id), "Component store has no component for this id!");
+		return m_Components[lookup(id)];
+	}
+
+	const T& get(id_t id) const {
+		SASSERT_MSG(contains(id), "Component store has no component for this id!");
+		return m_Components[lookup(id)];
+	}
+
+	T* tryGet(id_t id) {
+		uint32_t index = lookup(id);
+		return index != INVALID_INDEX ? &m_Components[index] : nullptr;
+	}
+
+	const T* tryGet(id_t id) const {
+		uint32_t index = lookup(id);
+		return index != INVALID_INDEX ? &m_Components[index] : nullptr;
+	}
+
+	// Exchanges two components in the packed array, their ids keep referring to them
+	void swapPositions(size_t a, size_t b) {
+		if (a == b) return;
+
+		std::swap(m_Components[a], m_Components[b]);
+		std::swap(m_Ids[a], m_Ids[b]);
+
+		sparseEntry(m_Ids[a]) = static_cast<uint32_t>(a);
+		sparseEntry(m_Ids[b]) = static_cast<uint32_t>(b);
+	}
+
+	// position of the component in the packed array
+	size_t getIndex(id_t id) const {
+		SASSERT_MSG(contains(id), "Component store has no component for this id!");
+		return lookup(id);
+	}
+
+	// packed access, indices are invalidated by remove() and swapPositions()
+	size_t size() const { return m_Components.size(); }
+	bool empty() const { return m_Components.empty(); }
+
+	T& operator[](size_t index) { return m_Components[index]; }
+	const T& operator[](size_t index) const { return m_Components[index]; }
+	id_t getId(size_t index) const { return m_Ids[index]; }
+
+	const std::vector<T>& getComponents() const { return m_Components; }
+	const std::vector<id_t>& getIds() const { return m_Ids; }
+
+	// Changes whenever a component is added, replaced or removed, but not when components are modified in place
+	uint64_t getVersion() const { return m_Version; }
+
+	auto begin() { return m_Components.begin(); }
+	auto end() { return m_Components.end(); }
+	auto begin() const { return m_Components.begin(); }
+	auto end() const { return m_Components.end(); }
+
+public:
+	static constexpr uint32_t INVALID_INDEX = ~0u;
+	static constexpr uint32_t PAGE_SIZE = 4096;
+
+private:
+	using Page = std::unique_ptr<uint32_t[]>;
+
+	uint32_t lookup(id_t id) const {
+		uint32_t idIndex = IdAllocator::getIndex(id);
+		size_t page = idIndex / PAGE_SIZE;
+
+		if (page >= m_Pages.size() || !m_Pages[page]) return INVALID_INDEX;
+
+		uint32_t index = m_Pages[page][idIndex % PAGE_SIZE];
+		return index != INVALID_INDEX && m_Ids[index] == id ? index : INVALID_INDEX;
+	}
+
+	uint32_t& sparseEntry(id_t id) {
+		uint32_t idIndex = IdAllocator::getIndex(id);
+		size_t page = idIndex / PAGE_SIZE;
+
+		if (page >= m_Pages.size()) {
+			m_Pages.resize(page + 1);
+		}
+
+		if (!m_Pages[page]) {
+			m_Pages[page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+			std::fill_n(m_Pages[page].get(), PAGE_SIZE, INVALID_INDEX);
+		}
+
+		return m_Pages[page][idIndex % PAGE_SIZE];
+	}
+
+private:
+	std::vector<T> m_Components;
+	std::vector<id_t> m_Ids;
+
+	// pages are only allocated for id ranges that are in use
+	std::vector<Page> m_Pages;
+
+	uint64_t m_Version{ 0 };
+};
+
+}
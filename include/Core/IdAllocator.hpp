@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace stl {
+
+// Hands out 32 bit ids made of an index and a generation. Freed indices are reused with the next generation, so an id
+// of a destroyed object never matches a live one until its generation wraps around. Indices are reused first in first
+// out and only once enough of them are free, which spreads the generations over many indices. All functions are thread safe,
+// allocating many ids at once only takes the lock once.
+class IdAllocator {
+public:
+	using id_t = uint32_t;
+
+public:
+	IdAllocator() = default;
+
+	IdAllocator(const IdAllocator&) = delete;
+	IdAllocator& operator=(const IdAllocator&) = delete;
+
+	id_t allocate();
+	void allocate(uint32_t count, std::vector<id_t>& ids);
+
+	// Ids that are not alive are ignored
+	void free(id_t id);
+
+	bool isAlive(id_t id) const;
+	size_t getAliveCount() const;
+
+	static constexpr uint32_t getIndex(id_t id) { return id & INDEX_MASK; }
+	static constexpr uint32_t getGeneration(id_t id) { return id >> INDEX_BITS; }
+	static constexpr id_t makeId(uint32_t index, uint32_t generation) { return (generation << INDEX_BITS) | index; }
+
+public:
+	static constexpr uint32_t INDEX_BITS = 22;
+	static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+	static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+	// the last index is never handed out, so that ~0 is never a valid id
+	static constexpr uint32_t MAX_INDEX_COUNT = INDEX_MASK;
+	static constexpr id_t INVALID_ID = ~0u;
+
+	static constexpr size_t MIN_FREE_INDICES = 1024;
+
+private:
+	id_t allocateLocked();
+
+private:
+	mutable std::mutex m_Mutex;
+
+	// current generation of every index, the top bit marks indices that are in use
+	std::vector<uint32_t> m_Slots;
+	std::deque<uint32_t> m_FreeIndices;
+	size_t m_AliveCount{ 0 };
+};
+
+}
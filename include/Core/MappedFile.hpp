@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace stl {
+
+class MappedFile {
+public:
+	MappedFile(const std::string& filepath);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool isOpen() const { return m_Data != nullptr; }
+	const char* getData() const { return static_cast<const char*>(m_Data); }
+	size_t getSize() const { return m_Size; }
+
+private:
+	void* m_Data{ nullptr };
+	size_t m_Size{ 0 };
+
+#ifdef _WIN32
+	void* m_File{ nullptr };
+	void* m_Mapping{ nullptr };
+#endif
+};
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace stl {
+
+class ThreadPool {
+public:
+	ThreadPool(size_t threadCount);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Shared pool with one worker per hardware thread besides the calling thread
+	static ThreadPool& get();
+
+	size_t getThreadCount() const { return m_Workers.size(); }
+
+	template<typename F>
+	std::future<std::invoke_result_t<F>> submit(F&& func) {
+		using Result = std::invoke_result_t<F>;
+
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+		std::future<Result> future = task->get_future();
+
+		enqueue([task]() { (*task)(); });
+
+		return future;
+	}
+
+	// Calls func(i) for every i in [0, count). The calling thread takes part in the work,
+	// so this is safe to use from inside a task running on this pool.
+	void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
+private:
+	void enqueue(std::function<void()> task);
+	void workerLoop();
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::queue<std::function<void()>> m_Tasks;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	bool m_Stopping{ false };
+};
+
+}
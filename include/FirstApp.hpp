@@ -7,8 +7,11 @@
 #include "renderer/wrapper/Device.hpp"
 #include "renderer/wrapper/Descriptors.hpp"
 #include "renderer/Model.hpp"
+#include "renderer/GeometryPool.hpp"
+#include "renderer/ModelLoader.hpp"
+#include "renderer/FrustumCuller.hpp"
 #include "renderer/Renderer.hpp"
-#include "GameObject.hpp"
+#include "Scene.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -41,10 +44,12 @@ private:
 	Window m_Window{ WIDTH, HEIGHT, "Starlight" };
 	Device m_Device{ m_Window };
 	Renderer m_Renderer{ m_Window, m_Device };
+	GeometryPool m_GeometryPool{ m_Device };
+	ModelLoader m_ModelLoader{ m_Device, m_GeometryPool };
 
 	std::unique_ptr<DescriptorPool> m_GlobalPool{};
 
-	GameObject::Map m_GameObjects;
+	Scene m_Scene;
 };
 
 }
\ No newline at end of file
@@ -1,57 +1,125 @@
 #pragma once
 
+#include "Core/IdAllocator.hpp"
 #include "renderer/Model.hpp"
+#include "Rotation.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <memory>
-#include <unordered_map>
-#include <optional>
 
 namespace stl {
 
-struct TransformComponent {
-	glm::vec3 translation;
-	glm::vec3 scale{ 1.0f, 1.0f, 1.0f };
-	glm::vec3 rotation;
+// Translation, rotation and scale of an object relative to its parent. The rotation is given either as YXZ euler angles
+// or as a quaternion, which avoids any trig when building the matrices. The model and normal matrices are
+// cached and only recomputed after one of the three changed, either lazily by the getters or in bulk by
+// Scene::updateTransforms(), which also propagates the world matrices of objects with a parent.
+class TransformComponent {
+public:
+	enum class RotationMode { EulerYXZ, Quaternion };
+
+public:
+	void setTranslation(const glm::vec3& translation);
+	void setScale(const glm::vec3& scale);
+
+	// Both switch the rotation mode, the orientation is expected to be normalized
+	void setRotation(const glm::vec3& rotation);
+	void setOrientation(const glm::quat& orientation);
+
+	const glm::vec3& getTranslation() const { return m_Translation; }
+	const glm::vec3& getScale() const { return m_Scale; }
+
+	// converted if the transform uses the other rotation mode
+	glm::vec3 getRotation() const;
+	glm::quat getOrientation() const;
+
+	RotationMode getRotationMode() const { return m_RotationMode; }
 
+	bool isDirty() const { return m_Dirty; }
+
+	// Set by the setters and only cleared by Scene::updateTransforms(), while the getters already clear the dirty flag
+	bool hasChanged() const { return m_Changed; }
+
+	// Recomputes both cached matrices if the transform changed
+	void updateMatrices() const;
+
+	const glm::mat4& getModelMatrix() const;
+	const glm::mat3& getNormalMatrix() const;
+
+	// computed from scratch on every call
 	glm::mat4 modelMatrix() const;
 	glm::mat3 normalMatrix() const;
+
+	// Include the transforms of all parents, equal to the model and normal matrix for objects without a parent
+	const glm::mat4& getWorldMatrix() const { return m_HasParent ? m_WorldMatrix : getModelMatrix(); }
+	const glm::mat3& getWorldNormalMatrix() const { return m_HasParent ? m_WorldNormalMatrix : getNormalMatrix(); }
+	glm::vec3 getWorldPosition() const { return glm::vec3(getWorldMatrix()[3]); }
+
+	bool hasParent() const { return m_HasParent; }
+
+private:
+	friend class TransformHierarchy;
+	friend class Scene;
+
+private:
+	glm::vec3 m_Translation{ 0.0f };
+	glm::vec3 m_Scale{ 1.0f, 1.0f, 1.0f };
+	glm::vec3 m_Rotation{ 0.0f };
+	glm::quat m_Orientation{ 1.0f, 0.0f, 0.0f, 0.0f };
+	RotationMode m_RotationMode{ RotationMode::EulerYXZ };
+
+	mutable glm::mat4 m_ModelMatrix{ 1.0f };
+	mutable glm::mat3 m_NormalMatrix{ 1.0f };
+	mutable bool m_Dirty{ false };
+	bool m_Changed{ false };
+
+	// written by the hierarchy
+	glm::mat4 m_WorldMatrix{ 1.0f };
+	glm::mat3 m_WorldNormalMatrix{ 1.0f };
+	bool m_HasParent{ false };
 };
 
 struct PointLightComponent {
+	glm::vec3 color{ 1.0f };
 	float lightIntensity = 1.0f;
+
+	// distance at which the light has faded out completely, lights are culled and clustered by the sphere it spans
+	float range = 5.0f;
+};
+
+struct ModelComponent {
+	std::shared_ptr<Model> model{};
 };
 
+class Scene;
+
+// Handle to an object of a scene, the components themselves are stored in the scene
 class GameObject {
 public:
-	using id_t = uint32_t;
-	using Map = std::unordered_map<id_t, GameObject>;
+	using id_t = IdAllocator::id_t;
 
 public:
-	GameObject(const GameObject&) = delete;
-	GameObject(GameObject&&) = default;
+	GameObject(Scene& scene, id_t objectId);
 
-	GameObject& operator=(const GameObject&) = delete;
-	GameObject& operator=(GameObject&&) = default;
+	id_t getId() const { return m_Id; };
 
-	static GameObject createGameObject();
-	static GameObject createPointLight(float intensity = 1.0f, float radius = 0.1f, glm::vec3 color = { 1.0f, 1.0f, 1.0f });
+	// false once the object has been destroyed, even if its index has been reused since
+	bool isValid() const;
 
-	id_t getId() const { return m_Id; };
+	Scene& getScene() const { return *m_Scene; }
 
-private:
-	GameObject(id_t objectId);
+	TransformComponent& getTransform() const;
 
-public:
-	std::shared_ptr<Model> p_Model{};
-	glm::vec3 p_Color{};
+	// null if the object has no such component
+	ModelComponent* getModel() const;
+	PointLightComponent* getPointLight() const;
 
-	TransformComponent p_Transform{};
-	std::optional<PointLightComponent> p_PointLight = std::nullopt;
+	void setModel(std::shared_ptr<Model> model) const;
+	void setParent(const GameObject& parent) const;
 
 private:
+	Scene* m_Scene;
 	id_t m_Id;
 };
 
-}
\ No newline at end of file
+}
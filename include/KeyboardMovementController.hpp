@@ -22,7 +22,7 @@ public:
 	};
 
 public:
-	void moveInPlaneXZ(float dt, GameObject& gameObject) const;
+	void moveInPlaneXZ(float dt, const GameObject& gameObject) const;
 
 public:
 	KeyMappings p_Keys{};
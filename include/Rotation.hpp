@@ -0,0 +1,26 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace stl {
+
+// Conversions between the YXZ euler angles used by TransformComponent and Camera::setViewYXZ (yaw around y, then
+// pitch around x, then roll around z) and quaternions. glm::slerp interpolates at constant speed along the shorter arc.
+namespace Rotation {
+
+	glm::quat fromEulerYXZ(const glm::vec3& rotation);
+
+	// Pitch is returned in [-pi/2, pi/2], at the poles the roll is folded into the yaw
+	glm::vec3 toEulerYXZ(const glm::quat& orientation);
+
+	glm::mat3 toMatrixYXZ(const glm::vec3& rotation);
+
+	// Normalized linear interpolation along the shorter arc, cheaper than slerp but slightly faster in the middle
+	glm::quat nlerp(const glm::quat& a, const glm::quat& b, float t);
+
+}
+
+}
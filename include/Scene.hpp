@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Core/ComponentStore.hpp"
+#include "GameObject.hpp"
+#include "TransformHierarchy.hpp"
+
+namespace stl {
+
+// Owns all game objects. Every component type lives in its own packed store, so systems only iterate
+// the objects that actually have the components they need.
+class Scene {
+public:
+	Scene() = default;
+
+	Scene(const Scene&) = delete;
+	Scene& operator=(const Scene&) = delete;
+
+	GameObject createGameObject();
+	GameObject createPointLight(float intensity = 1.0f, float radius = 0.1f, glm::vec3 color = { 1.0f, 1.0f, 1.0f }, float range = 5.0f);
+
+	// Ids can be reserved from any thread, the objects themselves are created on the thread owning the scene
+	GameObject::id_t reserveId() { return m_IdAllocator.allocate(); }
+	void reserveIds(uint32_t count, std::vector<GameObject::id_t>& ids) { m_IdAllocator.allocate(count, ids); }
+	GameObject createGameObject(GameObject::id_t reservedId);
+
+	// Destroying a parent keeps its children alive as roots. Also releases reserved ids that were never created.
+	void destroyGameObject(GameObject::id_t id);
+
+	// stale ids of destroyed objects are rejected by the generation
+	bool isAlive(GameObject::id_t id) const { return m_Transforms.contains(id); }
+
+	// Recomputes the cached matrices of all transforms changed since the last call and propagates them to the world
+	// matrices of their children, returns how many were updated
+	uint32_t updateTransforms();
+
+	// Ids of the transforms whose world matrix changed in the last updateTransforms() call, systems caching data
+	// derived from them compare the update count to know whether they have missed a call
+	const std::vector<GameObject::id_t>& getUpdatedTransforms() const { return m_UpdatedTransforms; }
+	uint64_t getTransformUpdateCount() const { return m_TransformUpdateCount; }
+
+	void setParent(GameObject::id_t child, GameObject::id_t parent) { m_Hierarchy.setParent(child, parent); }
+	void removeParent(GameObject::id_t child) { m_Hierarchy.removeParent(child); }
+	std::optional<GameObject::id_t> getParent(GameObject::id_t id) const { return m_Hierarchy.getParent(id); }
+
+	const TransformHierarchy& getHierarchy() const { return m_Hierarchy; }
+	const IdAllocator& getIdAllocator() const { return m_IdAllocator; }
+
+	GameObject getGameObject(GameObject::id_t id) { return GameObject{ *this, id }; }
+	size_t getGameObjectCount() const { return m_Transforms.size(); }
+
+	ComponentStore<TransformComponent>& getTransforms() { return m_Transforms; }
+	const ComponentStore<TransformComponent>& getTransforms() const { return m_Transforms; }
+
+	ComponentStore<ModelComponent>& getModels() { return m_Models; }
+	const ComponentStore<ModelComponent>& getModels() const { return m_Models; }
+
+	ComponentStore<PointLightComponent>& getPointLights() { return m_PointLights; }
+	const ComponentStore<PointLightComponent>& getPointLights() const { return m_PointLights; }
+
+private:
+	IdAllocator m_IdAllocator;
+
+	// every object has a transform
+	ComponentStore<TransformComponent> m_Transforms;
+	ComponentStore<ModelComponent> m_Models;
+	ComponentStore<PointLightComponent> m_PointLights;
+
+	TransformHierarchy m_Hierarchy{ m_Transforms };
+
+	std::vector<GameObject::id_t> m_UpdatedTransforms;
+	uint64_t m_TransformUpdateCount{ 0 };
+};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core/ComponentStore.hpp"
+#include "GameObject.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace stl {
+
+// Parent child relations between the transforms of a scene. Only objects with a parent or children are part of the
+// hierarchy. Whenever the structure changes, their transforms are moved to the front of the transform store in
+// breadth first order, so that parents always come before their children and the world matrices are propagated in
+// one linear pass over contiguous memory. Only subtrees with a changed transform are recomputed.
+class TransformHierarchy {
+public:
+	using id_t = GameObject::id_t;
+
+public:
+	TransformHierarchy(ComponentStore<TransformComponent>& transforms);
+
+	TransformHierarchy(const TransformHierarchy&) = delete;
+	TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+	// The local transform of the child is kept, so it moves with the parent from now on
+	void setParent(id_t child, id_t parent);
+	void removeParent(id_t child);
+
+	// Detaches the object from its parent and children, the children become roots
+	void remove(id_t id);
+
+	std::optional<id_t> getParent(id_t id) const;
+	void getChildren(id_t id, std::vector<id_t>& children) const;
+
+	// Recomputes the world matrices of all objects whose transform or any parent's transform changed,
+	// returns the number of objects updated and appends their ids to updated if given
+	uint32_t update(std::vector<id_t>* updated = nullptr);
+
+	size_t getNodeCount() const { return m_Nodes.size(); }
+
+public:
+	static constexpr id_t INVALID_ID = IdAllocator::INVALID_ID;
+	static constexpr uint32_t INVALID_SLOT = ~0u;
+
+private:
+	struct Node {
+		id_t parent{ INVALID_ID };
+		id_t firstChild{ INVALID_ID };
+		id_t nextSibling{ INVALID_ID };
+		id_t previousSibling{ INVALID_ID };
+	};
+
+	void unlink(id_t child);
+	void removeIfIsolated(id_t id);
+	void rebuildOrder();
+
+private:
+	ComponentStore<TransformComponent>& m_Transforms;
+	ComponentStore<Node> m_Nodes;
+
+	// breadth first, so every node comes after its parent. A slot is the position of the transform in the store.
+	std::vector<id_t> m_Order;
+	std::vector<uint32_t> m_ParentSlots;
+	std::vector<uint8_t> m_Changed;
+	bool m_OrderDirty{ false };
+};
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace stl {
+
+// Translations, YXZ euler rotations and scales as structure of arrays
+struct TransformArrays {
+	std::vector<float> translationX;
+	std::vector<float> translationY;
+	std::vector<float> translationZ;
+	std::vector<float> rotationX;
+	std::vector<float> rotationY;
+	std::vector<float> rotationZ;
+	std::vector<float> scaleX;
+	std::vector<float> scaleY;
+	std::vector<float> scaleZ;
+
+	size_t size() const { return scaleX.size(); }
+
+	void clear();
+	void push(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+};
+
+// Computes model and normal matrices of many transforms at once, 8 at a time with AVX2 or 4 with SSE. The vector paths
+// use a polynomial sine and cosine and agree with TransformComponent::modelMatrix() and normalMatrix() within a few ulps
+// for angles of moderate size. The scalar path uses the same expressions as the component and serves as reference.
+class TransformKernel {
+public:
+	enum class Path { Scalar, SSE, AVX2 };
+
+public:
+	static void computeMatrices(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices);
+	static void computeMatrices(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices, Path path);
+
+	static bool isSupported(Path path);
+	static Path getBestPath();
+	static const char* getPathName(Path path);
+};
+
+}
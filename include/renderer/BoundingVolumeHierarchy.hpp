@@ -0,0 +1,72 @@
+#pragma once
+
+#include "renderer/Bounds.hpp"
+#include "renderer/Frustum.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace stl {
+
+// Binned SAH tree over axis aligned boxes. Items are identified by their index in the array passed to build(),
+// moving items only requires update() and refit(), adding or removing items requires a new build().
+class BoundingVolumeHierarchy {
+public:
+	struct RayHit {
+		uint32_t item;
+		float distance;
+	};
+
+public:
+	void build(const std::vector<Aabb>& items);
+	void clear();
+
+	void update(uint32_t item, const Aabb& bounds);
+	void refit();
+
+	// Appends the indices of all items intersecting the query to result
+	void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& result) const;
+	void querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const;
+
+	// Closest item whose box is hit by the ray, direction does not have to be normalized
+	std::optional<RayHit> raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+
+	size_t getItemCount() const { return m_Items.size(); }
+	size_t getNodeCount() const { return m_Nodes.size(); }
+	const Aabb& getItemBounds(uint32_t item) const { return m_Items[item]; }
+
+public:
+	static constexpr uint32_t MAX_LEAF_SIZE = 4;
+	static constexpr uint32_t BIN_COUNT = 12;
+
+	// deeper nodes are split at the median, which bounds the depth of degenerate scenes
+	static constexpr uint32_t MAX_SAH_DEPTH = 64;
+
+private:
+	struct Node {
+		Aabb bounds;
+
+		// children are stored at first and first + 1 for inner nodes, leaves reference m_ItemOrder[first, first + count)
+		uint32_t first;
+		uint32_t count;
+	};
+
+	void buildNode(uint32_t begin, uint32_t end, uint32_t node, uint32_t depth);
+	void refitNode(uint32_t node);
+	void collect(uint32_t node, std::vector<uint32_t>& result) const;
+
+private:
+	std::vector<Aabb> m_Items;
+	std::vector<glm::vec3> m_Centroids;
+
+	std::vector<Node> m_Nodes;
+	std::vector<uint32_t> m_Parents;
+	std::vector<uint32_t> m_ItemOrder;
+	std::vector<uint32_t> m_LeafOfItem;
+
+	std::vector<uint32_t> m_DirtyLeaves;
+	std::vector<uint8_t> m_DirtyFlags;
+};
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace stl {
+
+struct Aabb {
+	glm::vec3 min{ 0.0f };
+	glm::vec3 max{ 0.0f };
+};
+
+// Axis aligned box and bounding sphere of a mesh in model space
+struct Bounds {
+	glm::vec3 min{ 0.0f };
+	glm::vec3 max{ 0.0f };
+
+	glm::vec3 center{ 0.0f };
+	float radius{ 0.0f };
+};
+
+}
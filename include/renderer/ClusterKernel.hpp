@@ -0,0 +1,48 @@
+#pragma once
+
+#include "renderer/Bounds.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace stl {
+
+// View space boxes of the light clusters as structure of arrays, so that several of them fit into one register
+struct BoxArrays {
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> minZ;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	std::vector<float> maxZ;
+
+	size_t size() const { return minX.size(); }
+
+	void clear();
+	void push(const Aabb& box);
+
+	// Appends boxes that never overlap anything, so that the vector paths can read a whole block past the last box
+	void pad();
+};
+
+// Tests a sphere against a contiguous range of boxes, 8 at a time with AVX2 or 4 with SSE. The vector paths mask off
+// the lanes of the last block instead of finishing with scalar code, they need the boxes to be padded.
+// The widest path supported by the cpu is picked at runtime, the scalar path serves as fallback and reference.
+class ClusterKernel {
+public:
+	enum class Path { Scalar, SSE, AVX2 };
+
+public:
+	// Writes the indices of all boxes in [begin, end) overlapping the sphere (center, radius) to hits, returns their number
+	static uint32_t intersectSphere(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits);
+	static uint32_t intersectSphere(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits, Path path);
+
+	static bool isSupported(Path path);
+	static Path getBestPath();
+	static const char* getPathName(Path path);
+
+public:
+	static constexpr uint32_t MAX_WIDTH = 8;
+};
+
+}
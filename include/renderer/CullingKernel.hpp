@@ -0,0 +1,39 @@
+#pragma once
+
+#include "renderer/Frustum.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace stl {
+
+// World space bounding spheres as structure of arrays, so that several of them fit into one register
+struct SphereArrays {
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> radius;
+
+	size_t size() const { return radius.size(); }
+
+	void clear();
+	void push(const glm::vec3& center, float sphereRadius);
+};
+
+// Tests batches of spheres against the six planes of a frustum, 8 at a time with AVX2 or 4 with SSE.
+// The widest path supported by the cpu is picked at runtime, the scalar path serves as fallback and reference.
+class CullingKernel {
+public:
+	enum class Path { Scalar, SSE, AVX2 };
+
+public:
+	// Writes 1 for every sphere intersecting the frustum and 0 otherwise, returns the number of visible spheres
+	static uint32_t cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visibility);
+	static uint32_t cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visibility, Path path);
+
+	static bool isSupported(Path path);
+	static Path getBestPath();
+	static const char* getPathName(Path path);
+};
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/wrapper/Descriptors.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace stl {
+
+struct FrameAllocation {
+	void* data{ nullptr };
+
+	// the buffer holding the allocation and a storage set over it, bound with the offset as dynamic offset
+	VkBuffer buffer{ VK_NULL_HANDLE };
+	VkDescriptorSet storageSet{ VK_NULL_HANDLE };
+
+	// from the start of the buffer, used as dynamic offset or directly for indirect draws
+	VkDeviceSize offset{ 0 };
+	VkDeviceSize size{ 0 };
+};
+
+// A persistently mapped buffer per frame in flight. Data that only lives for one frame is bump allocated from the
+// buffer of the current frame, which is reset once its fence has been waited on. When an allocation does not fit, the
+// frame moves on to a buffer of twice the size and keeps the old one alive until the frame comes around again, which
+// then starts with a single buffer large enough for all of it.
+// Storage descriptors cover a fixed binding range and are moved onto the allocations with dynamic offsets, a tail of
+// that size after every buffer keeps each such range inside it.
+class FrameAllocator {
+public:
+	FrameAllocator(Device& device, VkDeviceSize frameSize = DEFAULT_FRAME_SIZE, VkDeviceSize bindingRange = DEFAULT_BINDING_RANGE);
+
+	FrameAllocator(const FrameAllocator&) = delete;
+	FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+	// The fence of the frame has to be waited on, its buffers must no longer be read by the gpu
+	void beginFrame(int frameIndex);
+
+	FrameAllocation allocate(VkDeviceSize size, VkDeviceSize alignment);
+	FrameAllocation allocateUniform(VkDeviceSize size) { return allocate(size, m_UniformAlignment); }
+	// Throws if the allocation does not fit into the binding range, larger data has to be split into several draws
+	FrameAllocation allocateStorage(VkDeviceSize size);
+
+	// Makes everything allocated in the current frame visible to the gpu, has to be called before submitting
+	void flush();
+
+	// Layout of the storage sets, a single dynamic storage buffer at binding 0
+	VkDescriptorSetLayout getStorageSetLayout() const { return m_StorageSetLayout->getDescriptorSetLayout(); }
+
+	// Size of the buffer the current frame allocates from, grows when a frame needs more
+	VkDeviceSize getFrameSize() const { return m_Frames[m_FrameIndex].current.size; }
+	VkDeviceSize getBindingRange() const { return m_BindingRange; }
+	VkDeviceSize getUsedBytes() const;
+
+public:
+	static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = 8 * 1024 * 1024;
+	static constexpr VkDeviceSize DEFAULT_BINDING_RANGE = 4 * 1024 * 1024;
+
+	// live buffers of all frames, a frame only retires a few while doubling its size
+	static constexpr uint32_t MAX_BLOCKS = 64;
+
+private:
+	struct Block {
+		std::unique_ptr<Buffer> buffer;
+		VkDescriptorSet storageSet{ VK_NULL_HANDLE };
+
+		VkDeviceSize size{ 0 };
+		VkDeviceSize used{ 0 };
+	};
+
+	struct Frame {
+		Block current;
+
+		// outgrown within the frame, still read by the gpu until its fence is waited on
+		std::vector<Block> retired;
+	};
+
+	Block createBlock(VkDeviceSize size);
+	void freeBlocks(std::vector<Block>& blocks);
+
+private:
+	Device& m_Device;
+
+	std::unique_ptr<DescriptorSetLayout> m_StorageSetLayout;
+	std::unique_ptr<DescriptorPool> m_DescriptorPool;
+	std::vector<Frame> m_Frames;
+	int m_FrameIndex{ 0 };
+
+	VkDeviceSize m_BindingRange;
+	VkDeviceSize m_UniformAlignment;
+	VkDeviceSize m_StorageAlignment;
+	VkDeviceSize m_BlockAlignment;
+};
+
+}
@@ -1,15 +1,17 @@
 #pragma once
 
 #include "Camera.hpp"
-#include "GameObject.hpp"
+#include "Scene.hpp"
 
 #include <vulkan/vulkan.h>
 
-namespace stl {
+#include <vector>
 
-#define MAX_LIGHTS 10
+namespace stl {
 
+// layout matches the light buffer of the shaders
 struct PointLight {
+	// w holds the range of the light
 	glm::vec4 position{};
 	glm::vec4 color{};
 };
@@ -19,7 +21,10 @@ struct GlobalUbo {
 	glm::mat4 view{ 1.0f };
 	glm::mat4 inverseView{ 1.0f };
 	glm::vec4 ambientLightColor{ 1.0f, 1.0f, 1.0f, 0.02f };
-	PointLight pointLights[MAX_LIGHTS];
+
+	// xy map pixels to cluster columns and rows, zw map the log of the view depth to the depth slice
+	glm::vec4 clusterScale{ 0.0f };
+	glm::uvec4 clusterGridSize{ 0 };
 	int numLights;
 };
 
@@ -27,9 +32,17 @@ struct FrameInfo {
 	int frameIndex;
 	float frameTime;
 	VkCommandBuffer commandBuffer;
+	VkExtent2D extent;
 	Camera& camera;
 	VkDescriptorSet globalDescriptorSet;
-	GameObject::Map& gameObjects;
+
+	// lights and their clusters, written by PointLightSystem::update()
+	VkDescriptorSet lightDescriptorSet;
+	Scene& scene;
+
+	// objects with a model or point light that survived culling
+	std::vector<GameObject::id_t>& visibleObjects;
+	std::vector<GameObject::id_t>& visibleLights;
 };
 
 }
\ No newline at end of file
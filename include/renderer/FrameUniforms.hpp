@@ -0,0 +1,58 @@
+#pragma once
+
+#include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/FrameInfo.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace stl {
+
+struct UniformUploadStats {
+	VkDeviceSize writtenBytes{ 0 };
+	VkDeviceSize flushedBytes{ 0 };
+};
+
+// Holds the GlobalUbo of every frame in flight. Each frame keeps a copy of what its buffer contains, so an update only
+// writes the fields that differ from it and flushes the atoms of non coherent memory they fall into.
+class FrameUniforms {
+public:
+	FrameUniforms(Device& device);
+
+	FrameUniforms(const FrameUniforms&) = delete;
+	FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+	// The fence of the frame has to be waited on, its buffer must no longer be read by the gpu
+	void update(int frameIndex, const GlobalUbo& ubo);
+
+	VkDescriptorBufferInfo descriptorInfo(int frameIndex) { return m_Frames[frameIndex].buffer->descriptorInfo(); }
+
+	// bytes of the last update
+	const UniformUploadStats& getStats() const { return m_Stats; }
+
+private:
+	struct Range {
+		VkDeviceSize offset;
+		VkDeviceSize size;
+	};
+
+	struct FrameResources {
+		std::unique_ptr<Buffer> buffer;
+		GlobalUbo contents{};
+		bool written{ false };
+	};
+
+private:
+	Device& m_Device;
+	VkDeviceSize m_AtomSize;
+
+	std::vector<FrameResources> m_Frames;
+
+	// kept between frames to avoid reallocating
+	std::vector<Range> m_DirtyRanges;
+
+	UniformUploadStats m_Stats{};
+};
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace stl {
+
+// Planes of a view frustum pointing inwards, extracted from a (projection * view) matrix
+class Frustum {
+public:
+	enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+public:
+	Frustum() = default;
+	Frustum(const glm::mat4& viewProjection);
+
+	bool intersectsSphere(const glm::vec3& center, float radius) const;
+	bool intersectsBox(const glm::vec3& min, const glm::vec3& max) const;
+
+	const std::array<glm::vec4, Count>& getPlanes() const { return m_Planes; }
+
+private:
+	std::array<glm::vec4, Count> m_Planes{};
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "renderer/Frustum.hpp"
+#include "renderer/CullingKernel.hpp"
+#include "renderer/BoundingVolumeHierarchy.hpp"
+#include "Scene.hpp"
+#include "Camera.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace stl {
+
+struct CullingStats {
+	uint32_t visibleCount{ 0 };
+	uint32_t culledCount{ 0 };
+};
+
+// Keeps a bounding volume hierarchy over all objects with a model or a point light. The tree is rebuilt when models or
+// lights are added or removed, otherwise only the objects reported by Scene::updateTransforms() are updated and refit.
+// Boxes are culled through the tree first, the remaining candidates are then tested with their bounding spheres.
+class FrustumCuller {
+public:
+	void cull(const Camera& camera, const Scene& scene);
+
+	// Closest object whose world space box is hit by the ray
+	std::optional<GameObject::id_t> pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+	void queryObjects(const glm::vec3& center, float radius, std::vector<GameObject::id_t>& result) const;
+
+	const Frustum& getFrustum() const { return m_Frustum; }
+	const BoundingVolumeHierarchy& getHierarchy() const { return m_Hierarchy; }
+	GameObject::id_t getObject(uint32_t item) const { return m_Objects[item]; }
+
+	std::vector<GameObject::id_t>& getVisibleObjects() { return m_VisibleObjects; }
+	std::vector<GameObject::id_t>& getVisibleLights() { return m_VisibleLights; }
+	const CullingStats& getStats() const { return m_Stats; }
+
+private:
+	void gatherObjects(const Scene& scene);
+
+	// Returns whether the box of the item changed
+	bool updateBounds(const Scene& scene, uint32_t item);
+
+private:
+	Frustum m_Frustum{};
+	BoundingVolumeHierarchy m_Hierarchy;
+
+	// objects in the order of the hierarchy items, with their world space bounds
+	std::vector<GameObject::id_t> m_Objects;
+	std::vector<Aabb> m_Boxes;
+	std::vector<glm::vec4> m_Spheres;
+	ComponentStore<uint32_t> m_Items;
+
+	// state of the scene the items were last updated from
+	uint64_t m_ModelsVersion{ 0 };
+	uint64_t m_LightsVersion{ 0 };
+	uint64_t m_TransformUpdateCount{ 0 };
+
+	// kept between frames to avoid reallocating
+	std::vector<uint32_t> m_QueryItems;
+	SphereArrays m_QuerySpheres;
+	std::vector<uint8_t> m_Visibility;
+
+	std::vector<GameObject::id_t> m_VisibleObjects;
+	std::vector<GameObject::id_t> m_VisibleLights;
+	CullingStats m_Stats{};
+};
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Core/BlockSuballocator.hpp"
+#include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/wrapper/TransferContext.hpp"
+#include "renderer/Model.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace stl {
+
+// One large vertex and index buffer shared by many models. Models only own a range of each,
+// so all of them are drawn with a single bind and firstIndex / vertexOffset per draw.
+// The pool also owns the transfer context that all uploads into it are batched through.
+class GeometryPool {
+public:
+	GeometryPool(Device& device, uint32_t vertexCapacity = DEFAULT_VERTEX_CAPACITY, uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY);
+	~GeometryPool();
+
+	GeometryPool(const GeometryPool&) = delete;
+	GeometryPool& operator=(const GeometryPool&) = delete;
+
+	// Returns the first vertex / index of the range, throws if the pool is full
+	uint32_t allocateVertices(const std::vector<Model::Vertex>& vertices, TransferContext& transfer);
+	uint32_t allocateIndices(const std::vector<uint32_t>& indices, TransferContext& transfer);
+
+	// Freed ranges are only reused once the frame they were freed in is no longer in flight
+	void freeVertices(uint32_t firstVertex, uint32_t vertexCount);
+	void freeIndices(uint32_t firstIndex, uint32_t indexCount);
+
+	// The fence of the frame has to be waited on, the ranges freed the last time it was recorded become available
+	void beginFrame(int frameIndex);
+
+	void bind(VkCommandBuffer commandBuffer) const;
+
+	Device& getDevice() const { return m_Device; }
+	VkBuffer getVertexBuffer() const { return m_VertexBuffer->getBuffer(); }
+	VkBuffer getIndexBuffer() const { return m_IndexBuffer->getBuffer(); }
+	TransferContext& getTransferContext() { return m_Transfer; }
+	uint32_t getVertexCapacity() const { return static_cast<uint32_t>(m_VertexRanges.getSize()); }
+	uint32_t getIndexCapacity() const { return static_cast<uint32_t>(m_IndexRanges.getSize()); }
+	uint32_t getUsedVertexCount() const { return static_cast<uint32_t>(m_VertexRanges.getUsedSize()); }
+	uint32_t getUsedIndexCount() const { return static_cast<uint32_t>(m_IndexRanges.getUsedSize()); }
+
+public:
+	static constexpr uint32_t DEFAULT_VERTEX_CAPACITY = 1 << 20;
+	static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 1 << 22;
+
+private:
+	struct Range {
+		uint32_t first;
+		uint32_t count;
+	};
+
+	struct PendingFrees {
+		std::vector<Range> vertices;
+		std::vector<Range> indices;
+	};
+
+	void release(PendingFrees& frees);
+
+private:
+	Device& m_Device;
+
+	std::unique_ptr<Buffer> m_VertexBuffer;
+	std::unique_ptr<Buffer> m_IndexBuffer;
+
+	BlockSuballocator m_VertexRanges;
+	BlockSuballocator m_IndexRanges;
+
+	// one list per frame in flight, a frame that is still rendering might draw from these ranges
+	std::vector<PendingFrees> m_PendingFrees;
+	int m_FrameIndex{ 0 };
+
+	// destroyed before the buffers, it waits for the copies into them
+	TransferContext m_Transfer;
+};
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "renderer/ClusterKernel.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace stl {
+
+// Splits the view frustum into a grid of clusters, screen space tiles that are sliced exponentially along the view depth
+// (the distance along the negative z axis), and assigns every light to all clusters its sphere of influence overlaps.
+// The result is one contiguous list of light indices per cluster, so a fragment only looks at the lights of its cluster.
+// Every light only tests the clusters between the column, row and slice planes it touches, large light counts are
+// binned in parallel chunks that are merged without locking.
+class LightClusters {
+public:
+	// layout matches the cluster buffer of the shaders
+	struct Cluster {
+		uint32_t offset;
+		uint32_t count;
+	};
+
+public:
+	LightClusters(const glm::uvec3& gridSize = DEFAULT_GRID_SIZE);
+
+	// Recomputes the view space bounds of the clusters if the projection changed
+	void setProjection(const glm::mat4& projection);
+
+	// Spheres are given in view space as (center, radius), the light indices refer to their position in the array
+	void build(const std::vector<glm::vec4>& viewSpheres);
+	void build(const std::vector<glm::vec4>& viewSpheres, ClusterKernel::Path path, bool multithreaded);
+
+	const glm::uvec3& getGridSize() const { return m_GridSize; }
+	uint32_t getClusterCount() const { return m_GridSize.x * m_GridSize.y * m_GridSize.z; }
+
+	// Maps the log of the view depth to the depth slice: slice = log(depth) * x + y
+	glm::vec2 getDepthSliceScale() const { return m_DepthSliceScale; }
+
+	const std::vector<Cluster>& getClusters() const { return m_Clusters; }
+	const std::vector<uint32_t>& getLightIndices() const { return m_LightIndices; }
+	const BoxArrays& getClusterBounds() const { return m_ClusterBounds; }
+
+	uint32_t getClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const { return x + m_GridSize.x * (y + m_GridSize.y * slice); }
+
+public:
+	static constexpr glm::uvec3 DEFAULT_GRID_SIZE{ 16, 9, 24 };
+
+	// fewer lights are not worth waking up other threads for
+	static constexpr uint32_t MIN_LIGHTS_PER_CHUNK = 256;
+
+private:
+	// (cluster, light) pairs of a range of lights and how many of them each cluster received
+	struct Chunk {
+		std::vector<glm::uvec2> assignments;
+		std::vector<uint32_t> clusterCounts;
+		std::vector<uint32_t> hits;
+	};
+
+	void binLights(const std::vector<glm::vec4>& viewSpheres, uint32_t begin, uint32_t end, Chunk& chunk, ClusterKernel::Path path) const;
+
+	// slices covering [minDepth, maxDepth], false if the range lies outside of the clusters
+	bool getSliceRange(float minDepth, float maxDepth, uint32_t& first, uint32_t& last) const;
+
+	// tiles between the planes that the sphere overlaps, false if it lies outside of all of them
+	static bool getTileRange(const std::vector<glm::vec4>& planes, const glm::vec3& center, float radius, uint32_t& first, uint32_t& last);
+
+private:
+	glm::uvec3 m_GridSize;
+
+	glm::mat4 m_Projection{ 0.0f };
+	float m_Near{ 0.0f };
+	float m_Far{ 0.0f };
+	glm::vec2 m_DepthSliceScale{ 0.0f };
+
+	BoxArrays m_ClusterBounds;
+
+	// planes through the edges between the columns and rows, pointing towards the higher index
+	std::vector<glm::vec4> m_ColumnPlanes;
+	std::vector<glm::vec4> m_RowPlanes;
+
+	std::vector<Cluster> m_Clusters;
+	std::vector<uint32_t> m_LightIndices;
+
+	// kept between frames to avoid reallocating
+	std::vector<Chunk> m_Chunks;
+};
+
+}
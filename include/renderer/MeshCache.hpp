@@ -0,0 +1,24 @@
+#pragma once
+
+#include "renderer/Model.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace stl {
+
+// Binary cache for parsed meshes, stored next to the source asset as '<asset>.slmesh'.
+// Layout: Header, packed Model::Vertex array, uint32_t index array.
+class MeshCache {
+public:
+	static std::string getCachePath(const std::string& filepath);
+
+	static bool load(const std::string& filepath, Model::Data& data);
+	static bool store(const std::string& filepath, const Model::Data& data);
+
+public:
+	static constexpr uint32_t VERSION = 3;
+	static constexpr const char* EXTENSION = ".slmesh";
+};
+
+}
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "renderer/wrapper/Device.hpp"
-#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/wrapper/TransferContext.hpp"
+#include "renderer/Bounds.hpp"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -12,6 +13,9 @@
 
 namespace stl {
 
+class GeometryPool;
+
+// Vertex and index range inside a GeometryPool, the buffers are bound by whoever draws the model
 class Model {
 public:
 	struct Vertex {
@@ -32,35 +36,56 @@ public:
 		std::vector<Vertex> vertices{};
 		std::vector<uint32_t> indices{};
 
+		// vertices within this distance of an earlier one with the same other attributes are welded to it,
+		// 0 only merges identical vertices
+		float weldEpsilon{ 0.0f };
+
+		Bounds bounds{};
+
 		void loadModel(const std::string& filepath);
+		void loadObj(const std::string& filepath);
+		void computeBounds();
 	};
 
 public:
-	Model(Device& device, const Model::Data& data);
+	Model(GeometryPool& pool, const Model::Data& data);
+	Model(GeometryPool& pool, const Model::Data& data, TransferContext& transfer);
 	~Model();
 
 	Model(const Model&) = delete;
 	Model& operator=(const Model&) = delete;
 
-	static std::unique_ptr<Model> createModelFromFile(Device& device, const std::string& filepath);
+	static std::unique_ptr<Model> createModelFromFile(GeometryPool& pool, const std::string& filepath);
 
-	void bind(VkCommandBuffer commandBuffer);
-	void draw(VkCommandBuffer commandBuffer) const;
+	// firstInstance is passed on to gl_InstanceIndex, render systems use it to look up per-object data
+	void draw(VkCommandBuffer commandBuffer, uint32_t firstInstance = 0, uint32_t instanceCount = 1) const;
+	VkDrawIndexedIndirectCommand getDrawCommand(uint32_t firstInstance, uint32_t instanceCount = 1) const;
+
+	bool hasIndexBuffer() const { return m_HasIndexBuffer; }
+	uint32_t getFirstVertex() const { return m_FirstVertex; }
+	uint32_t getVertexCount() const { return m_VertexCount; }
+	uint32_t getFirstIndex() const { return m_FirstIndex; }
+	uint32_t getIndexCount() const { return m_IndexCount; }
+	const Bounds& getBounds() const { return m_Bounds; }
+
+	GeometryPool& getGeometryPool() const { return m_Pool; }
 
 private:
-	void createVertexBuffers(const std::vector<Vertex>& vertices);
-	void createIndexBuffers(const std::vector<uint32_t>& indices);
+	void createVertexBuffers(const std::vector<Vertex>& vertices, TransferContext& transfer);
+	void createIndexBuffers(const std::vector<uint32_t>& indices, TransferContext& transfer);
 
 private:
-	Device& m_Device;
+	GeometryPool& m_Pool;
 
-	std::unique_ptr<Buffer> m_VertexBuffer;
-	uint32_t m_VertexCount;
+	uint32_t m_FirstVertex{ 0 };
+	uint32_t m_VertexCount{ 0 };
 
 	bool m_HasIndexBuffer{ false };
 
-	std::unique_ptr<Buffer> m_IndexBuffer;
-	uint32_t m_IndexCount;
+	uint32_t m_FirstIndex{ 0 };
+	uint32_t m_IndexCount{ 0 };
+
+	Bounds m_Bounds;
 };
 
 }
\ No newline at end of file
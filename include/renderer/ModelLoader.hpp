@@ -0,0 +1,83 @@
+#pragma once
+
+#include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/TransferContext.hpp"
+#include "renderer/Model.hpp"
+#include "renderer/GeometryPool.hpp"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace stl {
+
+// Parses models on the shared thread pool and creates them on the main thread during update().
+// All models that become ready in one update are uploaded as a single transfer batch, a model
+// is handed out once the fence of its batch has signaled, so the render loop never waits on loading.
+class ModelLoader {
+public:
+	using Callback = std::function<void(std::shared_ptr<Model>)>;
+
+private:
+	struct Request {
+		std::string filepath;
+		std::future<Model::Data> data;
+		std::shared_ptr<Model> uploading{};
+		uint64_t uploadTicket{ 0 };
+		std::shared_ptr<Model> model{};
+		bool failed{ false };
+		Callback onReady;
+	};
+
+public:
+	// Placeholder for a model that may still be loading, only to be used on the main thread
+	class Handle {
+	public:
+		Handle() = default;
+
+		bool isValid() const { return m_Request != nullptr; }
+		bool isReady() const { return m_Request && m_Request->model != nullptr; }
+		bool hasFailed() const { return m_Request && m_Request->failed; }
+
+		std::shared_ptr<Model> get() const { return m_Request ? m_Request->model : nullptr; }
+
+	private:
+		Handle(std::shared_ptr<Request> request) : m_Request{ std::move(request) } {}
+
+	private:
+		std::shared_ptr<Request> m_Request;
+
+		friend class ModelLoader;
+	};
+
+public:
+	ModelLoader(Device& device, GeometryPool& pool);
+	~ModelLoader();
+
+	ModelLoader(const ModelLoader&) = delete;
+	ModelLoader& operator=(const ModelLoader&) = delete;
+
+	Handle load(const std::string& filepath, Callback onReady = {});
+
+	// Creates the models whose data is ready and invokes their callbacks
+	void update();
+	void waitIdle();
+
+	size_t getPendingCount() const { return m_Pending.size(); }
+
+private:
+	bool startUpload(Request& request);
+
+private:
+	Device& m_Device;
+	GeometryPool& m_Pool;
+
+	// shared with everything else uploading into the pool
+	TransferContext& m_Transfer;
+
+	std::vector<std::shared_ptr<Request>> m_Pending;
+};
+
+}
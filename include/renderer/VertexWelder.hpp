@@ -0,0 +1,52 @@
+#pragma once
+
+#include "renderer/Model.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace stl {
+
+// Open-addressing hash table that deduplicates vertices into an output array.
+// With a positive epsilon, a corner is welded to an earlier vertex with the same other attributes whose position
+// lies within epsilon of it. Positions are hashed by a grid of that size, so only the surrounding cells are searched.
+class VertexWelder {
+public:
+	VertexWelder(std::vector<Model::Vertex>& vertices, size_t expectedCount, float epsilon = 0.0f);
+
+	VertexWelder(const VertexWelder&) = delete;
+	VertexWelder& operator=(const VertexWelder&) = delete;
+
+	uint32_t weld(const Model::Vertex& vertex);
+
+private:
+	struct Key {
+		uint32_t words[sizeof(Model::Vertex) / sizeof(uint32_t)];
+	};
+
+	Key makeKey(const Model::Vertex& vertex, const glm::vec3& cellOffset = glm::vec3{ 0.0f }) const;
+	static uint64_t hashKey(const Key& key);
+
+	// slot based local index of the first vertex with the key that is also accepted, EMPTY if there is none
+	template<typename F>
+	uint32_t find(const Key& key, uint64_t hash, F&& accept) const;
+
+	void insert(uint32_t local, uint64_t hash);
+	void grow();
+
+private:
+	static constexpr uint32_t EMPTY = UINT32_MAX;
+
+	std::vector<Model::Vertex>& m_Vertices;
+	uint32_t m_Base;
+
+	std::vector<uint32_t> m_Slots;
+	std::vector<uint32_t> m_Tags;
+	std::vector<Key> m_Keys;
+	size_t m_Mask;
+
+	float m_InvEpsilon;
+	float m_EpsilonSquared;
+};
+
+}
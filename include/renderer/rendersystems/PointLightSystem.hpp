@@ -2,7 +2,12 @@
 
 #include "renderer/wrapper/Pipeline.hpp"
 #include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/wrapper/Descriptors.hpp"
 #include "renderer/Model.hpp"
+#include "renderer/LightClusters.hpp"
+#include "renderer/CullingKernel.hpp"
+#include "renderer/FrameAllocator.hpp"
 #include "renderer/FrameInfo.hpp"
 #include "GameObject.hpp"
 #include "Camera.hpp"
@@ -17,15 +22,18 @@
 
 namespace stl {
 
-struct PointLightPushConstants {
+// per-light billboard data, read in the vertex shader through gl_InstanceIndex
+struct PointLightInstance {
+	// w holds the radius of the billboard
 	glm::vec4 position{};
 	glm::vec4 color{};
-	float radius;
 };
 
+// Uploads the point lights whose range reaches into the view together with their assignment to the light clusters
+// for the lit shaders, and draws a billboard for every visible light.
 class PointLightSystem {
 public:
-	PointLightSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout);
+	PointLightSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, FrameAllocator& frameAllocator);
 	~PointLightSystem();
 
 	PointLightSystem(const PointLightSystem&) = delete;
@@ -34,15 +42,58 @@ public:
 	void update(FrameInfo& frameInfo, GlobalUbo& ubo);
 	void render(FrameInfo& frameInfo);
 
+	// set with the light, cluster and light index buffers, stays the same for a frame index while the buffers grow
+	VkDescriptorSetLayout getLightSetLayout() const { return m_LightSetLayout->getDescriptorSetLayout(); }
+	VkDescriptorSet getLightDescriptorSet(int frameIndex) const { return m_Frames[frameIndex].lightDescriptorSet; }
+
+	const LightClusters& getClusters() const { return m_Clusters; }
+
 private:
+	struct LightSortKey {
+		float distanceSquared;
+		uint32_t light;
+	};
+
+	struct FrameResources {
+		std::unique_ptr<Buffer> lightBuffer;
+		std::unique_ptr<Buffer> clusterBuffer;
+		std::unique_ptr<Buffer> lightIndexBuffer;
+		VkDescriptorSet lightDescriptorSet{ VK_NULL_HANDLE };
+	};
+
+	void createSetLayouts();
 	void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
 	void createPipeline(VkRenderPass renderPass);
 
+	void reserveLights(FrameResources& frame, uint32_t lightCount, uint32_t indexCount);
+
+public:
+	static constexpr uint32_t INITIAL_LIGHT_CAPACITY = 1024;
+
 private:
 	Device& m_Device;
+	FrameAllocator& m_FrameAllocator;
+
+	std::unique_ptr<DescriptorSetLayout> m_LightSetLayout;
+	std::unique_ptr<DescriptorPool> m_DescriptorPool;
+	std::vector<FrameResources> m_Frames;
+
+	LightClusters m_Clusters;
+
+	// world space spheres of influence of all lights and which of them reach into the view
+	SphereArrays m_InfluenceSpheres;
+	std::vector<uint8_t> m_Visibility;
+
+	// lights in the order of the light buffer and their view space spheres
+	std::vector<PointLight> m_Lights;
+	std::vector<glm::vec4> m_LightSpheres;
 
 	std::unique_ptr<Pipeline> m_Pipeline;
 	VkPipelineLayout m_PipelineLayout;
+
+	// reused every frame, only the small keys are sorted
+	std::vector<PointLightInstance> m_SortedLights;
+	std::vector<LightSortKey> m_SortKeys;
 };
 
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include "renderer/wrapper/Pipeline.hpp"
 #include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/wrapper/Descriptors.hpp"
 #include "renderer/Model.hpp"
+#include "renderer/GeometryPool.hpp"
+#include "renderer/FrameAllocator.hpp"
 #include "renderer/FrameInfo.hpp"
 #include "GameObject.hpp"
 #include "Camera.hpp"
@@ -17,14 +21,15 @@
 
 namespace stl {
 
-struct SimplePushConstantData {
+// per-object data, read in the vertex shader through gl_InstanceIndex
+struct SimpleObjectData {
 	glm::mat4 modelMatrix{ 1.0f };
 	glm::mat4 normalMatrix{ 1.0f };
 };
 
 class SimpleRenderSystem {
 public:
-	SimpleRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout);
+	SimpleRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout lightSetLayout, FrameAllocator& frameAllocator);
 	~SimpleRenderSystem();
 
 	SimpleRenderSystem(const SimpleRenderSystem&) = delete;
@@ -32,15 +37,32 @@ public:
 
 	void renderGameObjects(FrameInfo& frameInfo);
 
+	// Indirect drawing is only available if the device supports drawIndirectFirstInstance
+	void setIndirectEnabled(bool enabled) { m_IndirectEnabled = enabled && m_Device.p_Features.drawIndirectFirstInstance; }
+	bool isIndirectEnabled() const { return m_IndirectEnabled; }
+
 private:
-	void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
+	struct DrawItem {
+		const Model* model;
+		const TransformComponent* transform;
+	};
+
+	void createPipelineLayout(VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout lightSetLayout);
 	void createPipeline(VkRenderPass renderPass);
 
+	void recordDraws(VkCommandBuffer commandBuffer, const FrameAllocation& commands, uint32_t firstCommand, uint32_t commandCount);
+
 private:
 	Device& m_Device;
+	FrameAllocator& m_FrameAllocator;
+
+	// reused every frame to avoid reallocating
+	std::vector<DrawItem> m_DrawItems;
+
+	bool m_IndirectEnabled;
 
 	std::unique_ptr<Pipeline> m_Pipeline;
 	VkPipelineLayout m_PipelineLayout;
 };
 
-}
\ No newline at end of file
+}
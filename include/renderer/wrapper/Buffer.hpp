@@ -15,12 +15,12 @@ public:
 	VkResult map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 	void unmap();
 
-	void writeToBuffer(void* data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+	void writeToBuffer(const void* data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 	VkResult flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 	VkDescriptorBufferInfo descriptorInfo(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 	VkResult invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 
-	void writeToIndex(void* data, int index);
+	void writeToIndex(const void* data, int index);
 	VkResult flushIndex(int index);
 	VkDescriptorBufferInfo descriptorInfoForIndex(int index);
 	VkResult invalidateIndex(int index);
@@ -42,7 +42,7 @@ private:
 
 	void* m_Mapped{ nullptr };
 	VkBuffer m_Buffer{ VK_NULL_HANDLE };
-	VkDeviceMemory m_Memory{ VK_NULL_HANDLE };
+	Allocation m_Allocation{};
 
 	VkDeviceSize m_BufferSize;
 	uint32_t m_InstanceCount;
@@ -3,6 +3,7 @@
 #include "renderer/wrapper/Window.hpp"
 #include "renderer/wrapper/Instance.hpp"
 #include "renderer/wrapper/PhysicalDevice.hpp"
+#include "renderer/wrapper/MemoryAllocator.hpp"
 
 #include <string>
 #include <vector>
@@ -27,19 +28,20 @@ public:
 	VkSurfaceKHR getSurface() const { return m_Surface; }
 	VkQueue getGraphicsQueue() const { return m_GraphicsQueue; }
 	VkQueue getPresentQueue() const { return m_PresentQueue; }
+	MemoryAllocator& getAllocator() const { return *m_Allocator; }
 
 	SwapchainSupportDetails getSwapchainSupport();
 	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
 	QueueFamilyIndices findPhysicalQueueFamilies() const;
 	VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features) const;
 
-	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) const;
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, Allocation& allocation) const;
 	VkCommandBuffer beginSingleTimeCommands() const;
 	void endSingleTimeCommands(VkCommandBuffer commandBuffer) const;
-	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const;
+	void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0) const;
 	void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t layerCount) const;
 
-	void createImageWithInfo(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) const;
+	void createImageWithInfo(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags properties, VkImage& image, Allocation& allocation) const;
 
 private:
 	void createSurface();
@@ -50,6 +52,9 @@ private:
 public:
 	VkPhysicalDeviceProperties p_Properties;
 
+	// features that were actually enabled on the logical device
+	VkPhysicalDeviceFeatures p_Features;
+
 private:
 	Instance m_Instance;
 	std::shared_ptr<PhysicalDevice> m_PhysicalDevice;
@@ -62,6 +67,8 @@ private:
 	VkQueue m_GraphicsQueue;
 	VkQueue m_PresentQueue;
 
+	std::unique_ptr<MemoryAllocator> m_Allocator;
+
 	const std::vector<const char*> m_DeviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 };
 
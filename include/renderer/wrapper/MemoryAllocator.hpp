@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Core/BlockSuballocator.hpp"
+#include "renderer/wrapper/MemoryBackend.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace stl {
+
+struct Allocation {
+	VkDeviceMemory memory{ VK_NULL_HANDLE };
+	VkDeviceSize offset{ 0 };
+	VkDeviceSize size{ 0 };
+
+	// start of this allocation inside the persistently mapped block, null if not host visible
+	void* mapped{ nullptr };
+
+	uint32_t poolIndex{ 0 };
+	uint32_t blockIndex{ 0 };
+	bool dedicated{ false };
+};
+
+// Suballocates buffers and images from large vkAllocateMemory blocks, one pool per memory type
+// and resource kind (linear / optimal tiling) so that bufferImageGranularity never has to be considered.
+class MemoryAllocator {
+public:
+	struct Statistics {
+		uint32_t blockCount{ 0 };
+		uint32_t dedicatedAllocationCount{ 0 };
+		uint32_t allocationCount{ 0 };
+		VkDeviceSize reservedBytes{ 0 };
+		VkDeviceSize usedBytes{ 0 };
+		VkDeviceSize largestFreeRange{ 0 };
+		size_t freeRangeCount{ 0 };
+	};
+
+public:
+	MemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice);
+	MemoryAllocator(std::unique_ptr<MemoryBackend> backend);
+	~MemoryAllocator();
+
+	MemoryAllocator(const MemoryAllocator&) = delete;
+	MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+	Allocation allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear);
+	void free(Allocation& allocation);
+
+	VkResult flush(const Allocation& allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
+	VkResult invalidate(const Allocation& allocation, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
+
+	// Releases blocks without any live allocations
+	void trim();
+
+	Statistics getStatistics() const;
+
+	// Flushes and invalidations of non coherent memory cover whole multiples of this
+	VkDeviceSize getNonCoherentAtomSize() const { return m_NonCoherentAtomSize; }
+
+	// Called for every block, e.g. to decide which blocks are fragmented enough to be worth compacting
+	template<typename F>
+	void forEachBlock(F&& func) const {
+		std::lock_guard<std::mutex> lock{ m_Mutex };
+
+		for (const Pool& pool : m_Pools) {
+			for (const auto& block : pool.blocks) {
+				if (block) func(pool.memoryTypeIndex, block->memory, block->suballocator);
+			}
+		}
+	}
+
+private:
+	struct Block {
+		VkDeviceMemory memory;
+		void* mapped;
+		BlockSuballocator suballocator;
+		uint32_t allocationCount;
+	};
+
+	struct Pool {
+		uint32_t memoryTypeIndex;
+		std::vector<std::unique_ptr<Block>> blocks;
+	};
+
+	uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+	VkDeviceMemory allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void** mapped);
+	void freeDeviceMemory(VkDeviceMemory memory, void* mapped);
+	VkMappedMemoryRange mappedRange(const Allocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+
+public:
+	static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+private:
+	std::unique_ptr<MemoryBackend> m_Backend;
+	VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+	VkDeviceSize m_NonCoherentAtomSize;
+
+	std::vector<Pool> m_Pools;
+	uint32_t m_DedicatedAllocationCount{ 0 };
+	VkDeviceSize m_DedicatedBytes{ 0 };
+
+	mutable std::mutex m_Mutex;
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+namespace stl {
+
+// The device memory calls made by the MemoryAllocator, so that its bookkeeping can be tested without a gpu
+class MemoryBackend {
+public:
+	virtual ~MemoryBackend() = default;
+
+	virtual const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const = 0;
+	virtual VkDeviceSize getNonCoherentAtomSize() const = 0;
+
+	virtual VkResult allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory* memory) = 0;
+	virtual void freeMemory(VkDeviceMemory memory) = 0;
+
+	// Maps the whole memory object
+	virtual VkResult mapMemory(VkDeviceMemory memory, void** mapped) = 0;
+	virtual void unmapMemory(VkDeviceMemory memory) = 0;
+
+	virtual VkResult flushMemory(const VkMappedMemoryRange& range) = 0;
+	virtual VkResult invalidateMemory(const VkMappedMemoryRange& range) = 0;
+};
+
+class VulkanMemoryBackend : public MemoryBackend {
+public:
+	VulkanMemoryBackend(VkDevice device, VkPhysicalDevice physicalDevice);
+
+	const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const override { return m_MemoryProperties; }
+	VkDeviceSize getNonCoherentAtomSize() const override { return m_NonCoherentAtomSize; }
+
+	VkResult allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory* memory) override;
+	void freeMemory(VkDeviceMemory memory) override;
+
+	VkResult mapMemory(VkDeviceMemory memory, void** mapped) override;
+	void unmapMemory(VkDeviceMemory memory) override;
+
+	VkResult flushMemory(const VkMappedMemoryRange& range) override;
+	VkResult invalidateMemory(const VkMappedMemoryRange& range) override;
+
+private:
+	VkDevice m_Device;
+	VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+	VkDeviceSize m_NonCoherentAtomSize;
+};
+
+}
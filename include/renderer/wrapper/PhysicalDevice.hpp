@@ -44,6 +44,7 @@ public:
 
 public:
 	VkPhysicalDeviceProperties p_Properties;
+	VkPhysicalDeviceFeatures p_Features;
 
 private:
 	Instance& m_Instance;
@@ -60,7 +60,7 @@ private:
 	VkRenderPass m_RenderPass;
 
 	std::vector<VkImage> m_DepthImages;
-	std::vector<VkDeviceMemory> m_DepthImageMemories;
+	std::vector<Allocation> m_DepthImageAllocations;
 	std::vector<VkImageView> m_DepthImageViews;
 	std::vector<VkImage> m_SwapchainImages;
 	std::vector<VkImageView> m_SwapchainImageViews;
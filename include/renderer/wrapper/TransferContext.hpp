@@ -0,0 +1,67 @@
+#pragma once
+
+#include "renderer/wrapper/Device.hpp"
+#include "renderer/wrapper/Buffer.hpp"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace stl {
+
+// Batches buffer uploads: data is staged in a persistently mapped ring buffer, all copies are
+// recorded into one command buffer and each submitted batch signals a fence that callers can poll or wait on.
+class TransferContext {
+public:
+	TransferContext(Device& device, VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+	~TransferContext();
+
+	TransferContext(const TransferContext&) = delete;
+	TransferContext& operator=(const TransferContext&) = delete;
+
+	// Returns the ticket of the batch the copy was recorded into
+	uint64_t upload(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+	uint64_t submit();
+	bool isComplete(uint64_t ticket);
+	void wait(uint64_t ticket);
+	void waitIdle();
+
+	uint64_t getRecordingTicket() const { return m_NextTicket; }
+
+private:
+	struct Batch {
+		VkCommandBuffer commandBuffer;
+		VkFence fence;
+		uint64_t ticket;
+		uint64_t stagingEnd;
+	};
+
+	VkDeviceSize allocateStaging(VkDeviceSize size);
+	VkCommandBuffer getCommandBuffer();
+	void retire(bool block);
+
+public:
+	static constexpr VkDeviceSize DEFAULT_STAGING_SIZE = 32 * 1024 * 1024;
+
+private:
+	static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+	Device& m_Device;
+
+	std::unique_ptr<Buffer> m_StagingBuffer;
+	VkDeviceSize m_StagingSize;
+
+	// absolute byte positions, the ring offset is position % m_StagingSize
+	uint64_t m_Head{ 0 };
+	uint64_t m_Tail{ 0 };
+
+	Batch m_Recording{ VK_NULL_HANDLE, VK_NULL_HANDLE, 0, 0 };
+	std::deque<Batch> m_InFlight;
+	std::vector<Batch> m_FreeBatches;
+
+	uint64_t m_NextTicket{ 1 };
+	uint64_t m_CompletedTicket{ 0 };
+};
+
+}
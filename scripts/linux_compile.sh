@@ -1,2 +0,0 @@
-glslc shaders/SimpleShader.vert -o shaders/SimpleShader.vert.spv
-glslc shaders/SimpleShader.frag -o shaders/SimpleShader.frag.spv
\ No newline at end of file
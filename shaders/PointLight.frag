@@ -1,29 +1,20 @@
 #version 450
 
 layout(location = 0) in vec2 sOffset;
+layout(location = 1) flat in vec4 sColor;
 
 layout(location = 0) out vec4 outColor;
 
-struct PointLight {
-	vec4 position;
-	vec4 color;
-};
-
 layout(set = 0, binding = 0) uniform GlobalUbo {
 	mat4 projection;
 	mat4 view;
 	mat4 inverseView;
 	vec4 ambientLightColor;
-	PointLight pointLights[10];
+	vec4 clusterScale;
+	uvec4 clusterGridSize;
 	int numLights;
 } ubo;
 
-layout(push_constant) uniform Push {
-	vec4 position;
-	vec4 color;
-	float radius;
-} push;
-
 const float PI = 3.14159265359;
 
 void main() {
@@ -34,5 +25,5 @@ void main() {
 	}
 	float cosTerm = 0.5 * (cos(distSquared * PI) + 1.0);
 
-	outColor = vec4(push.color.rgb + cosTerm, cosTerm);
+	outColor = vec4(sColor.rgb + cosTerm, cosTerm);
 }
\ No newline at end of file
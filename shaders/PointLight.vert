@@ -1,26 +1,27 @@
 #version 450
 
 layout(location = 0) out vec2 sOffset;
-
-struct PointLight {
-	vec4 position;
-	vec4 color;
-};
+layout(location = 1) flat out vec4 sColor;
 
 layout(set = 0, binding = 0) uniform GlobalUbo {
 	mat4 projection;
 	mat4 view;
 	mat4 inverseView;
 	vec4 ambientLightColor;
-	PointLight pointLights[10];
+	vec4 clusterScale;
+	uvec4 clusterGridSize;
 	int numLights;
 } ubo;
 
-layout(push_constant) uniform Push {
+// position.w holds the radius of the billboard
+struct LightInstance {
 	vec4 position;
 	vec4 color;
-	float radius;
-} push;
+};
+
+layout(set = 1, binding = 0) readonly buffer InstanceBuffer {
+	LightInstance lights[];
+} instanceBuffer;
 
 const vec2 OFFSETS[6] = vec2[](
 	vec2(-1.0, -1.0),
@@ -34,10 +35,13 @@ const vec2 OFFSETS[6] = vec2[](
 const float LIGHT_RADIUS = 0.1;
 
 void main() {
+	LightInstance light = instanceBuffer.lights[gl_InstanceIndex];
+
 	sOffset = OFFSETS[gl_VertexIndex];
+	sColor = light.color;
 
-	vec4 camSpaceLightPos = ubo.view * vec4(push.position.xyz, 1.0);
-	vec4 camSpacePos = camSpaceLightPos + push.radius * vec4(sOffset, 0.0, 0.0);
+	vec4 camSpaceLightPos = ubo.view * vec4(light.position.xyz, 1.0);
+	vec4 camSpacePos = camSpaceLightPos + light.position.w * vec4(sOffset, 0.0, 0.0);
 
 	gl_Position = ubo.projection * camSpacePos;
 }
\ No newline at end of file
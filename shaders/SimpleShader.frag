@@ -3,9 +3,11 @@
 layout(location = 0) in vec3 sColor;
 layout(location = 1) in vec3 sWorldPos;
 layout(location = 2) in vec3 sNormal;
+layout(location = 3) in float sViewDepth;
 
 layout(location = 0) out vec4 outColor;
 
+// position.w holds the range of the light
 struct PointLight {
 	vec4 position;
 	vec4 color;
@@ -16,14 +18,31 @@ layout(set = 0, binding = 0) uniform GlobalUbo {
 	mat4 view;
 	mat4 inverseView;
 	vec4 ambientLightColor;
-	PointLight pointLights[10];
+	vec4 clusterScale;
+	uvec4 clusterGridSize;
 	int numLights;
 } ubo;
 
-layout(push_constant) uniform Push {
-	mat4 modelMatrix;
-	mat4 normalMatrix;
-} push;
+layout(set = 2, binding = 0) readonly buffer LightBuffer {
+	PointLight lights[];
+} lightBuffer;
+
+// offset and count of the light indices of every cluster
+layout(set = 2, binding = 1) readonly buffer ClusterBuffer {
+	uvec2 clusters[];
+} clusterBuffer;
+
+layout(set = 2, binding = 2) readonly buffer LightIndexBuffer {
+	uint indices[];
+} lightIndexBuffer;
+
+uint clusterIndex() {
+	uvec2 tile = min(uvec2(gl_FragCoord.xy * ubo.clusterScale.xy), ubo.clusterGridSize.xy - 1u);
+	float slice = floor(log(max(sViewDepth, 1e-4)) * ubo.clusterScale.z + ubo.clusterScale.w);
+	uint depthSlice = uint(clamp(slice, 0.0, float(ubo.clusterGridSize.z - 1u)));
+
+	return tile.x + ubo.clusterGridSize.x * (tile.y + ubo.clusterGridSize.y * depthSlice);
+}
 
 void main() {
 	vec3 diffuseLight = ubo.ambientLightColor.rgb * ubo.ambientLightColor.a;
@@ -33,11 +52,24 @@ void main() {
 	vec3 worldCamPos = ubo.inverseView[3].xyz;
 	vec3 viewDirection = normalize(worldCamPos - sWorldPos.xyz);
 
-	for (int i = 0; i < ubo.numLights; i++) {
-		PointLight light = ubo.pointLights[i];
+	uvec2 cluster = clusterBuffer.clusters[clusterIndex()];
+
+	for (uint i = 0u; i < cluster.y; i++) {
+		PointLight light = lightBuffer.lights[lightIndexBuffer.indices[cluster.x + i]];
 
 		vec3 directionToLight = light.position.xyz - sWorldPos.xyz;
-		float attenuation = 1.0 / dot(directionToLight, directionToLight);
+		float distSquared = dot(directionToLight, directionToLight);
+
+		float rangeSquared = light.position.w * light.position.w;
+
+		if (distSquared >= rangeSquared) {
+			continue;
+		}
+
+		// inverse square falloff, windowed so that it reaches zero at the range of the light
+		float ratio = distSquared / rangeSquared;
+		float window = 1.0 - ratio * ratio;
+		float attenuation = window * window / max(distSquared, 1e-4);
 
 		directionToLight = normalize(directionToLight);
 
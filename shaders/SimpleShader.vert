@@ -8,32 +8,37 @@ layout(location = 3) in vec2 inUV;
 layout(location = 0) out vec3 sColor;
 layout(location = 1) out vec3 sWorldPos;
 layout(location = 2) out vec3 sNormal;
-
-struct PointLight {
-	vec4 position;
-	vec4 color;
-};
+layout(location = 3) out float sViewDepth;
 
 layout(set = 0, binding = 0) uniform GlobalUbo {
 	mat4 projection;
 	mat4 view;
 	mat4 inverseView;
 	vec4 ambientLightColor;
-	PointLight pointLights[10];
+	vec4 clusterScale;
+	uvec4 clusterGridSize;
 	int numLights;
 } ubo;
 
-layout(push_constant) uniform Push {
+struct ObjectData {
 	mat4 modelMatrix;
 	mat4 normalMatrix;
-} push;
+};
+
+layout(set = 1, binding = 0) readonly buffer ObjectBuffer {
+	ObjectData objects[];
+} objectBuffer;
 
 void main() {
-	vec4 worldPosition = push.modelMatrix * vec4(inPosition, 1.0);
+	ObjectData object = objectBuffer.objects[gl_InstanceIndex];
+
+	vec4 worldPosition = object.modelMatrix * vec4(inPosition, 1.0);
+	vec4 viewPosition = ubo.view * worldPosition;
 
-	gl_Position = ubo.projection * ubo.view * worldPosition;
+	gl_Position = ubo.projection * viewPosition;
 
 	sColor = inColor;
 	sWorldPos = worldPosition.xyz;
-	sNormal = normalize(mat3(push.normalMatrix) * inNormal);
+	sNormal = normalize(mat3(object.normalMatrix) * inNormal);
+	sViewDepth = -viewPosition.z;
 }
\ No newline at end of file
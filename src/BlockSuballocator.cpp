@@ -0,0 +1,98 @@
+#include "Core/BlockSuballocator.hpp"
+
+#include "Core/Asserts.hpp"
+
+namespace stl {
+
+BlockSuballocator::BlockSuballocator(uint64_t size)
+	: m_Size{ size }, m_FreeSize{ 0 } {
+	if (size > 0) {
+		insertFreeRange(0, size);
+		m_FreeSize = size;
+	}
+}
+
+std::optional<uint64_t> BlockSuballocator::allocate(uint64_t size, uint64_t alignment) {
+	if (size == 0 || size > m_FreeSize) {
+		return std::nullopt;
+	}
+
+	// smallest free range first, larger ones are only needed if the alignment does not fit
+	for (auto it = m_FreeBySize.lower_bound(size); it != m_FreeBySize.end(); ++it) {
+		uint64_t rangeSize = it->first;
+		uint64_t rangeOffset = it->second;
+
+		uint64_t alignedOffset = (rangeOffset + alignment - 1) / alignment * alignment;
+
+		if (alignedOffset + size > rangeOffset + rangeSize) continue;
+
+		eraseFreeRange(m_FreeByOffset.find(rangeOffset));
+
+		if (alignedOffset > rangeOffset) {
+			insertFreeRange(rangeOffset, alignedOffset - rangeOffset);
+		}
+
+		if (alignedOffset + size < rangeOffset + rangeSize) {
+			insertFreeRange(alignedOffset + size, rangeOffset + rangeSize - alignedOffset - size);
+		}
+
+		m_FreeSize -= size;
+
+		return alignedOffset;
+	}
+
+	return std::nullopt;
+}
+
+void BlockSuballocator::free(uint64_t offset, uint64_t size) {
+	SASSERT_MSG(offset + size <= m_Size, "Freed range is outside of the block");
+
+	m_FreeSize += size;
+
+	auto next = m_FreeByOffset.lower_bound(offset);
+
+	// merge with the following free range
+	if (next != m_FreeByOffset.end() && next->first == offset + size) {
+		size += next->second;
+		eraseFreeRange(next);
+	}
+
+	// merge with the preceding free range
+	auto prev = m_FreeByOffset.lower_bound(offset);
+
+	if (prev != m_FreeByOffset.begin()) {
+		--prev;
+
+		if (prev->first + prev->second == offset) {
+			offset = prev->first;
+			size += prev->second;
+			eraseFreeRange(prev);
+		}
+	}
+
+	insertFreeRange(offset, size);
+}
+
+uint64_t BlockSuballocator::getLargestFreeRange() const {
+	return m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+}
+
+void BlockSuballocator::insertFreeRange(uint64_t offset, uint64_t size) {
+	m_FreeByOffset.emplace(offset, size);
+	m_FreeBySize.emplace(size, offset);
+}
+
+void BlockSuballocator::eraseFreeRange(std::map<uint64_t, uint64_t>::iterator it) {
+	auto [begin, end] = m_FreeBySize.equal_range(it->second);
+
+	for (auto sizeIt = begin; sizeIt != end; ++sizeIt) {
+		if (sizeIt->second == it->first) {
+			m_FreeBySize.erase(sizeIt);
+			break;
+		}
+	}
+
+	m_FreeByOffset.erase(it);
+}
+
+}
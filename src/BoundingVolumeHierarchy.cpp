@@ -0,0 +1,490 @@
+#include "renderer/BoundingVolumeHierarchy.hpp"
+
+#include "Core/Asserts.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace stl {
+
+namespace {
+
+constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t ALL_PLANES = (1 << Frustum::Count) - 1;
+
+// enough for MAX_SAH_DEPTH plus a median split tree over any realistic item count
+constexpr uint32_t STACK_SIZE = 128;
+
+Aabb emptyAabb() {
+	constexpr float inf = std::numeric_limits<float>::infinity();
+	return Aabb{ glm::vec3{ inf }, glm::vec3{ -inf } };
+}
+
+void grow(Aabb& aabb, const Aabb& other) {
+	aabb.min = glm::min(aabb.min, other.min);
+	aabb.max = glm::max(aabb.max, other.max);
+}
+
+void grow(Aabb& aabb, const glm::vec3& point) {
+	aabb.min = glm::min(aabb.min, point);
+	aabb.max = glm::max(aabb.max, point);
+}
+
+float surfaceArea(const Aabb& aabb) {
+	glm::vec3 extent = aabb.max - aabb.min;
+
+	if (extent.x < 0.0f) return 0.0f;
+
+	return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+bool isOutside(const glm::vec4& plane, const Aabb& aabb) {
+	glm::vec3 positive{
+		plane.x >= 0.0f ? aabb.max.x : aabb.min.x,
+		plane.y >= 0.0f ? aabb.max.y : aabb.min.y,
+		plane.z >= 0.0f ? aabb.max.z : aabb.min.z
+	};
+
+	return glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f;
+}
+
+bool isInside(const glm::vec4& plane, const Aabb& aabb) {
+	glm::vec3 negative{
+		plane.x >= 0.0f ? aabb.min.x : aabb.max.x,
+		plane.y >= 0.0f ? aabb.min.y : aabb.max.y,
+		plane.z >= 0.0f ? aabb.min.z : aabb.max.z
+	};
+
+	return glm::dot(glm::vec3(plane), negative) + plane.w >= 0.0f;
+}
+
+bool overlapsSphere(const Aabb& aabb, const glm::vec3& center, float radius) {
+	glm::vec3 closest = glm::clamp(center, aabb.min, aabb.max);
+	glm::vec3 offset = closest - center;
+
+	return glm::dot(offset, offset) <= radius * radius;
+}
+
+// entry distance of the ray into the box, or infinity if it is missed within maxDistance
+float intersectRay(const Aabb& aabb, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+	constexpr float miss = std::numeric_limits<float>::infinity();
+
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+
+	for (int axis = 0; axis < 3; axis++) {
+		float t0 = (aabb.min[axis] - origin[axis]) * inverseDirection[axis];
+		float t1 = (aabb.max[axis] - origin[axis]) * inverseDirection[axis];
+
+		if (t0 > t1) std::swap(t0, t1);
+
+		// comparisons written so that NaNs from 0 * inf leave the interval untouched
+		tMin = t0 > tMin ? t0 : tMin;
+		tMax = t1 < tMax ? t1 : tMax;
+
+		if (tMin > tMax) return miss;
+	}
+
+	return tMin;
+}
+
+}
+
+void BoundingVolumeHierarchy::build(const std::vector<Aabb>& items) {
+	clear();
+
+	if (items.empty()) {
+		return;
+	}
+
+	m_Items = items;
+	m_Centroids.resize(items.size());
+	m_ItemOrder.resize(items.size());
+	m_LeafOfItem.resize(items.size());
+
+	for (uint32_t i = 0; i < items.size(); i++) {
+		m_Centroids[i] = (items[i].min + items[i].max) * 0.5f;
+		m_ItemOrder[i] = i;
+	}
+
+	// a binary tree with at least one item per leaf never has more than 2n - 1 nodes
+	m_Nodes.reserve(2 * items.size());
+	m_Parents.reserve(2 * items.size());
+
+	m_Nodes.push_back({});
+	m_Parents.push_back(NO_PARENT);
+
+	buildNode(0, static_cast<uint32_t>(items.size()), 0, 0);
+
+	m_DirtyFlags.assign(m_Nodes.size(), 0);
+}
+
+void BoundingVolumeHierarchy::clear() {
+	m_Items.clear();
+	m_Centroids.clear();
+	m_Nodes.clear();
+	m_Parents.clear();
+	m_ItemOrder.clear();
+	m_LeafOfItem.clear();
+	m_DirtyLeaves.clear();
+	m_DirtyFlags.clear();
+}
+
+void BoundingVolumeHierarchy::buildNode(uint32_t begin, uint32_t end, uint32_t node, uint32_t depth) {
+	Aabb bounds = emptyAabb();
+	Aabb centroidBounds = emptyAabb();
+
+	for (uint32_t i = begin; i < end; i++) {
+		grow(bounds, m_Items[m_ItemOrder[i]]);
+		grow(centroidBounds, m_Centroids[m_ItemOrder[i]]);
+	}
+
+	m_Nodes[node].bounds = bounds;
+
+	uint32_t count = end - begin;
+
+	auto makeLeaf = [&]() {
+		m_Nodes[node].first = begin;
+		m_Nodes[node].count = count;
+
+		for (uint32_t i = begin; i < end; i++) {
+			m_LeafOfItem[m_ItemOrder[i]] = node;
+		}
+	};
+
+	if (count <= MAX_LEAF_SIZE) {
+		makeLeaf();
+		return;
+	}
+
+	struct Bin {
+		Aabb bounds;
+		uint32_t count;
+	};
+
+	// pick the cheapest split over all axes, cost is the surface area of each side times its item count
+	float bestCost = std::numeric_limits<float>::infinity();
+	int bestAxis = -1;
+	uint32_t bestSplit = 0;
+
+	glm::vec3 centroidExtent = centroidBounds.max - centroidBounds.min;
+
+	for (int axis = 0; axis < 3 && depth < MAX_SAH_DEPTH; axis++) {
+		if (centroidExtent[axis] <= 0.0f) continue;
+
+		float scale = BIN_COUNT / centroidExtent[axis];
+
+		Bin bins[BIN_COUNT];
+
+		for (Bin& bin : bins) {
+			bin = { emptyAabb(), 0 };
+		}
+
+		for (uint32_t i = begin; i < end; i++) {
+			uint32_t item = m_ItemOrder[i];
+			uint32_t bin = std::min(BIN_COUNT - 1, static_cast<uint32_t>((m_Centroids[item][axis] - centroidBounds.min[axis]) * scale));
+
+			bins[bin].count++;
+			grow(bins[bin].bounds, m_Items[item]);
+		}
+
+		float leftArea[BIN_COUNT - 1];
+		uint32_t leftCount[BIN_COUNT - 1];
+
+		Aabb leftBounds = emptyAabb();
+		uint32_t leftSum = 0;
+
+		for (uint32_t i = 0; i < BIN_COUNT - 1; i++) {
+			grow(leftBounds, bins[i].bounds);
+			leftSum += bins[i].count;
+
+			leftArea[i] = surfaceArea(leftBounds);
+			leftCount[i] = leftSum;
+		}
+
+		Aabb rightBounds = emptyAabb();
+		uint32_t rightSum = 0;
+
+		for (uint32_t i = BIN_COUNT - 1; i > 0; i--) {
+			grow(rightBounds, bins[i].bounds);
+			rightSum += bins[i].count;
+
+			if (leftCount[i - 1] == 0 || rightSum == 0) continue;
+
+			float cost = leftArea[i - 1] * leftCount[i - 1] + surfaceArea(rightBounds) * rightSum;
+
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = i;
+			}
+		}
+	}
+
+	uint32_t middle;
+
+	if (bestAxis >= 0) {
+		if (bestCost >= surfaceArea(bounds) * count && count <= 2 * MAX_LEAF_SIZE) {
+			makeLeaf();
+			return;
+		}
+
+		float scale = BIN_COUNT / centroidExtent[bestAxis];
+		float minimum = centroidBounds.min[bestAxis];
+
+		auto it = std::partition(m_ItemOrder.begin() + begin, m_ItemOrder.begin() + end, [&](uint32_t item) {
+			return std::min(BIN_COUNT - 1, static_cast<uint32_t>((m_Centroids[item][bestAxis] - minimum) * scale)) < bestSplit;
+		});
+
+		middle = static_cast<uint32_t>(it - m_ItemOrder.begin());
+	} else {
+		// too deep or all centroids coincide, split the largest axis at the median
+		int axis = 0;
+
+		if (centroidExtent.y > centroidExtent[axis]) axis = 1;
+		if (centroidExtent.z > centroidExtent[axis]) axis = 2;
+
+		middle = begin + count / 2;
+
+		std::nth_element(m_ItemOrder.begin() + begin, m_ItemOrder.begin() + middle, m_ItemOrder.begin() + end, [&](uint32_t a, uint32_t b) {
+			return m_Centroids[a][axis] < m_Centroids[b][axis];
+		});
+	}
+
+	uint32_t left = static_cast<uint32_t>(m_Nodes.size());
+
+	m_Nodes.resize(left + 2);
+	m_Parents.resize(left + 2, node);
+
+	m_Nodes[node].first = left;
+	m_Nodes[node].count = 0;
+
+	buildNode(begin, middle, left, depth + 1);
+	buildNode(middle, end, left + 1, depth + 1);
+}
+
+void BoundingVolumeHierarchy::update(uint32_t item, const Aabb& bounds) {
+	SASSERT_MSG(item < m_Items.size(), "Item index out of range");
+
+	m_Items[item] = bounds;
+
+	uint32_t leaf = m_LeafOfItem[item];
+
+	if (!m_DirtyFlags[leaf]) {
+		m_DirtyFlags[leaf] = 1;
+		m_DirtyLeaves.push_back(leaf);
+	}
+}
+
+void BoundingVolumeHierarchy::refit() {
+	if (m_DirtyLeaves.empty()) {
+		return;
+	}
+
+	// with many moving items a single sweep is cheaper than walking up from every leaf,
+	// children are always stored after their parent
+	if (m_DirtyLeaves.size() * 8 > m_Nodes.size()) {
+		for (size_t i = m_Nodes.size(); i-- > 0;) {
+			refitNode(static_cast<uint32_t>(i));
+		}
+	} else {
+		for (uint32_t leaf : m_DirtyLeaves) {
+			for (uint32_t node = leaf; node != NO_PARENT; node = m_Parents[node]) {
+				Aabb previous = m_Nodes[node].bounds;
+				refitNode(node);
+
+				// earlier leaves may already have grown the parents to these bounds
+				if (node != leaf && previous.min == m_Nodes[node].bounds.min && previous.max == m_Nodes[node].bounds.max) break;
+			}
+		}
+	}
+
+	for (uint32_t leaf : m_DirtyLeaves) {
+		m_DirtyFlags[leaf] = 0;
+	}
+
+	m_DirtyLeaves.clear();
+}
+
+void BoundingVolumeHierarchy::refitNode(uint32_t node) {
+	Node& current = m_Nodes[node];
+
+	if (current.count > 0) {
+		current.bounds = emptyAabb();
+
+		for (uint32_t i = current.first; i < current.first + current.count; i++) {
+			grow(current.bounds, m_Items[m_ItemOrder[i]]);
+		}
+	} else {
+		current.bounds = m_Nodes[current.first].bounds;
+		grow(current.bounds, m_Nodes[current.first + 1].bounds);
+	}
+}
+
+void BoundingVolumeHierarchy::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& result) const {
+	if (m_Nodes.empty()) {
+		return;
+	}
+
+	const auto& planes = frustum.getPlanes();
+
+	struct Entry {
+		uint32_t node;
+		uint32_t planeMask;
+	};
+
+	Entry stack[STACK_SIZE];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = { 0, ALL_PLANES };
+
+	while (stackSize > 0) {
+		Entry entry = stack[--stackSize];
+		const Node& node = m_Nodes[entry.node];
+
+		// planes the node is completely inside of do not need to be tested for its children
+		bool outside = false;
+		uint32_t planeMask = entry.planeMask;
+
+		for (uint32_t p = 0; p < Frustum::Count; p++) {
+			if (!(planeMask & (1 << p))) continue;
+
+			if (isOutside(planes[p], node.bounds)) {
+				outside = true;
+				break;
+			}
+
+			if (isInside(planes[p], node.bounds)) {
+				planeMask &= ~(1 << p);
+			}
+		}
+
+		if (outside) continue;
+
+		if (planeMask == 0) {
+			collect(entry.node, result);
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				uint32_t item = m_ItemOrder[i];
+				bool visible = true;
+
+				for (uint32_t p = 0; p < Frustum::Count && visible; p++) {
+					if (planeMask & (1 << p)) visible = !isOutside(planes[p], m_Items[item]);
+				}
+
+				if (visible) result.push_back(item);
+			}
+		} else {
+			SASSERT_MSG(stackSize + 2 <= STACK_SIZE, "Bounding volume hierarchy is too deep");
+
+			stack[stackSize++] = { node.first, planeMask };
+			stack[stackSize++] = { node.first + 1, planeMask };
+		}
+	}
+}
+
+void BoundingVolumeHierarchy::querySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const {
+	if (m_Nodes.empty()) {
+		return;
+	}
+
+	uint32_t stack[STACK_SIZE];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_Nodes[stack[--stackSize]];
+
+		if (!overlapsSphere(node.bounds, center, radius)) continue;
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				if (overlapsSphere(m_Items[m_ItemOrder[i]], center, radius)) result.push_back(m_ItemOrder[i]);
+			}
+		} else {
+			SASSERT_MSG(stackSize + 2 <= STACK_SIZE, "Bounding volume hierarchy is too deep");
+
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = node.first + 1;
+		}
+	}
+}
+
+std::optional<BoundingVolumeHierarchy::RayHit> BoundingVolumeHierarchy::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+	if (m_Nodes.empty()) {
+		return std::nullopt;
+	}
+
+	glm::vec3 inverseDirection = 1.0f / direction;
+
+	std::optional<RayHit> closest;
+	float closestDistance = maxDistance;
+
+	constexpr float miss = std::numeric_limits<float>::infinity();
+
+	if (intersectRay(m_Nodes[0].bounds, origin, inverseDirection, closestDistance) == miss) {
+		return std::nullopt;
+	}
+
+	uint32_t stack[STACK_SIZE];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const Node& node = m_Nodes[stack[--stackSize]];
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				uint32_t item = m_ItemOrder[i];
+				float distance = intersectRay(m_Items[item], origin, inverseDirection, closestDistance);
+
+				if (distance != miss && distance <= closestDistance) {
+					closestDistance = distance;
+					closest = RayHit{ item, distance };
+				}
+			}
+
+			continue;
+		}
+
+		// visit the nearer child first so that the farther one is more likely to be pruned
+		float leftDistance = intersectRay(m_Nodes[node.first].bounds, origin, inverseDirection, closestDistance);
+		float rightDistance = intersectRay(m_Nodes[node.first + 1].bounds, origin, inverseDirection, closestDistance);
+
+		uint32_t nearChild = node.first;
+		uint32_t farChild = node.first + 1;
+
+		if (rightDistance < leftDistance) {
+			std::swap(leftDistance, rightDistance);
+			std::swap(nearChild, farChild);
+		}
+
+		SASSERT_MSG(stackSize + 2 <= STACK_SIZE, "Bounding volume hierarchy is too deep");
+
+		if (rightDistance != miss && rightDistance <= closestDistance) stack[stackSize++] = farChild;
+		if (leftDistance != miss && leftDistance <= closestDistance) stack[stackSize++] = nearChild;
+	}
+
+	return closest;
+}
+
+void BoundingVolumeHierarchy::collect(uint32_t node, std::vector<uint32_t>& result) const {
+	uint32_t stack[STACK_SIZE];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = node;
+
+	while (stackSize > 0) {
+		const Node& current = m_Nodes[stack[--stackSize]];
+
+		if (current.count > 0) {
+			result.insert(result.end(), m_ItemOrder.begin() + current.first, m_ItemOrder.begin() + current.first + current.count);
+		} else {
+			stack[stackSize++] = current.first;
+			stack[stackSize++] = current.first + 1;
+		}
+	}
+}
+
+}
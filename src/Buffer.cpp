@@ -11,30 +11,34 @@ Buffer::Buffer(Device& device, VkDeviceSize instanceSize, uint32_t instanceCount
 	m_AlignmentSize = getAlignment(m_InstanceSize, minOffsetAlignment);
 	m_BufferSize = m_AlignmentSize * m_InstanceCount;
 
-	device.createBuffer(m_BufferSize, m_UsageFlags, m_MemoryPropertyFlags, m_Buffer, m_Memory);
+	device.createBuffer(m_BufferSize, m_UsageFlags, m_MemoryPropertyFlags, m_Buffer, m_Allocation);
 }
 
 Buffer::~Buffer() {
 	unmap();
 
 	vkDestroyBuffer(m_Device.getDevice(), m_Buffer, nullptr);
-	vkFreeMemory(m_Device.getDevice(), m_Memory, nullptr);
+	m_Device.getAllocator().free(m_Allocation);
 }
 
 VkResult Buffer::map(VkDeviceSize size, VkDeviceSize offset) {
-	SASSERT_MSG(m_Buffer && m_Memory, "Called map on buffer before create");
+	SASSERT_MSG(m_Buffer && m_Allocation.memory, "Called map on buffer before create");
 
-	return vkMapMemory(m_Device.getDevice(), m_Memory, offset, size, 0, &m_Mapped);
+	// host visible blocks are persistently mapped by the allocator, mapping only hands out a pointer
+	if (!m_Allocation.mapped) {
+		return VK_ERROR_MEMORY_MAP_FAILED;
+	}
+
+	m_Mapped = static_cast<char*>(m_Allocation.mapped) + offset;
+
+	return VK_SUCCESS;
 }
 
 void Buffer::unmap() {
-	if (m_Mapped) {
-		vkUnmapMemory(m_Device.getDevice(), m_Memory);
-		m_Mapped = nullptr;
-	}
+	m_Mapped = nullptr;
 }
 
-void Buffer::writeToBuffer(void* data, VkDeviceSize size, VkDeviceSize offset) {
+void Buffer::writeToBuffer(const void* data, VkDeviceSize size, VkDeviceSize offset) {
 	SASSERT_MSG(m_Mapped, "Cannot copy to unmapped buffer");
 
 	if (size == VK_WHOLE_SIZE) {
@@ -48,13 +52,7 @@ void Buffer::writeToBuffer(void* data, VkDeviceSize size, VkDeviceSize offset) {
 }
 
 VkResult Buffer::flush(VkDeviceSize size, VkDeviceSize offset) {
-	VkMappedMemoryRange mappedRange{};
-	mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-	mappedRange.memory = m_Memory;
-	mappedRange.offset = offset;
-	mappedRange.size = size;
-
-	return vkFlushMappedMemoryRanges(m_Device.getDevice(), 1, &mappedRange);
+	return m_Device.getAllocator().flush(m_Allocation, size, offset);
 }
 
 VkDescriptorBufferInfo Buffer::descriptorInfo(VkDeviceSize size, VkDeviceSize offset) {
@@ -62,16 +60,10 @@ VkDescriptorBufferInfo Buffer::descriptorInfo(VkDeviceSize size, VkDeviceSize of
 }
 
 VkResult Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset) {
-	VkMappedMemoryRange mappedRange{};
-	mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-	mappedRange.memory = m_Memory;
-	mappedRange.offset = offset;
-	mappedRange.size = size;
-
-	return vkInvalidateMappedMemoryRanges(m_Device.getDevice(), 1, &mappedRange);
+	return m_Device.getAllocator().invalidate(m_Allocation, size, offset);
 }
 
-void Buffer::writeToIndex(void* data, int index) {
+void Buffer::writeToIndex(const void* data, int index) {
 	writeToBuffer(data, m_InstanceSize, index * m_AlignmentSize);
 }
 
@@ -33,8 +33,6 @@ void Camera::setViewTarget(const glm::vec3& position, const glm::vec3& target, c
 }
 
 void Camera::setViewYXZ(const glm::vec3& position, const glm::vec3& rotation) {
-	m_Position = position;
-
 	const float c3 = glm::cos(rotation.z);
 	const float s3 = glm::sin(rotation.z);
 	const float c2 = glm::cos(rotation.x);
@@ -46,6 +44,19 @@ void Camera::setViewYXZ(const glm::vec3& position, const glm::vec3& rotation) {
 	const glm::vec3 v{ (c3 * s1 * s2 - c1 * s3), (c2 * c3), (c1 * c3 * s2 + s1 * s3) };
 	const glm::vec3 w{ (c2 * s1), (-s2), (c1 * c2) };
 
+	setViewBasis(position, u, v, w);
+}
+
+void Camera::setViewRotation(const glm::vec3& position, const glm::quat& orientation) {
+	// the columns of the rotation are the axes of the camera, no trig required
+	const glm::mat3 rotation = glm::mat3_cast(orientation);
+
+	setViewBasis(position, rotation[0], rotation[1], rotation[2]);
+}
+
+void Camera::setViewBasis(const glm::vec3& position, const glm::vec3& u, const glm::vec3& v, const glm::vec3& w) {
+	m_Position = position;
+
 	m_ViewMatrix = glm::mat4{ 1.f };
 	m_ViewMatrix[0][0] = u.x;
 	m_ViewMatrix[1][0] = u.y;
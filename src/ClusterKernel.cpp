@@ -0,0 +1,192 @@
+#include "renderer/ClusterKernel.hpp"
+
+#include "Core/Common.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CLUSTER_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#endif
+
+namespace stl {
+
+namespace {
+
+// same arithmetic order as the vector paths, so that all of them agree on every box
+uint32_t intersectScalar(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits) {
+	float radiusSquared = sphere.w * sphere.w;
+	uint32_t hitCount = 0;
+
+	for (uint32_t i = begin; i < end; i++) {
+		float dx = std::max(std::max(boxes.minX[i] - sphere.x, sphere.x - boxes.maxX[i]), 0.0f);
+		float dy = std::max(std::max(boxes.minY[i] - sphere.y, sphere.y - boxes.maxY[i]), 0.0f);
+		float dz = std::max(std::max(boxes.minZ[i] - sphere.z, sphere.z - boxes.maxZ[i]), 0.0f);
+
+		float distanceSquared = dx * dx + dy * dy;
+		distanceSquared = distanceSquared + dz * dz;
+
+		if (distanceSquared <= radiusSquared) {
+			hits[hitCount++] = i;
+		}
+	}
+
+	return hitCount;
+}
+
+#if CLUSTER_X86
+
+TARGET_SSE uint32_t intersectSSE(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits) {
+	__m128 centerX = _mm_set1_ps(sphere.x);
+	__m128 centerY = _mm_set1_ps(sphere.y);
+	__m128 centerZ = _mm_set1_ps(sphere.z);
+	__m128 radiusSquared = _mm_set1_ps(sphere.w * sphere.w);
+	__m128 zero = _mm_setzero_ps();
+
+	uint32_t hitCount = 0;
+
+	for (uint32_t i = begin; i < end; i += 4) {
+		__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.minX[i]), centerX), _mm_sub_ps(centerX, _mm_loadu_ps(&boxes.maxX[i]))), zero);
+		__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.minY[i]), centerY), _mm_sub_ps(centerY, _mm_loadu_ps(&boxes.maxY[i]))), zero);
+		__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.minZ[i]), centerZ), _mm_sub_ps(centerZ, _mm_loadu_ps(&boxes.maxZ[i]))), zero);
+
+		__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		distanceSquared = _mm_add_ps(distanceSquared, _mm_mul_ps(dz, dz));
+
+		unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(distanceSquared, radiusSquared)));
+
+		// lanes past the end belong to other rows or the padding
+		if (end - i < 4) mask &= (1u << (end - i)) - 1;
+
+		while (mask) {
+			hits[hitCount++] = i + std::countr_zero(mask);
+			mask &= mask - 1;
+		}
+	}
+
+	return hitCount;
+}
+
+TARGET_AVX2 uint32_t intersectAVX2(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits) {
+	__m256 centerX = _mm256_set1_ps(sphere.x);
+	__m256 centerY = _mm256_set1_ps(sphere.y);
+	__m256 centerZ = _mm256_set1_ps(sphere.z);
+	__m256 radiusSquared = _mm256_set1_ps(sphere.w * sphere.w);
+	__m256 zero = _mm256_setzero_ps();
+
+	uint32_t hitCount = 0;
+
+	for (uint32_t i = begin; i < end; i += 8) {
+		__m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.minX[i]), centerX), _mm256_sub_ps(centerX, _mm256_loadu_ps(&boxes.maxX[i]))), zero);
+		__m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.minY[i]), centerY), _mm256_sub_ps(centerY, _mm256_loadu_ps(&boxes.maxY[i]))), zero);
+		__m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.minZ[i]), centerZ), _mm256_sub_ps(centerZ, _mm256_loadu_ps(&boxes.maxZ[i]))), zero);
+
+		__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		distanceSquared = _mm256_add_ps(distanceSquared, _mm256_mul_ps(dz, dz));
+
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LE_OQ)));
+
+		if (end - i < 8) mask &= (1u << (end - i)) - 1;
+
+		while (mask) {
+			hits[hitCount++] = i + std::countr_zero(mask);
+			mask &= mask - 1;
+		}
+	}
+
+	return hitCount;
+}
+
+#endif
+
+}
+
+void BoxArrays::clear() {
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+void BoxArrays::pad() {
+	// inverted boxes are infinitely far away from every sphere
+	for (uint32_t i = 0; i < ClusterKernel::MAX_WIDTH - 1; i++) {
+		minX.push_back(std::numeric_limits<float>::max());
+		minY.push_back(std::numeric_limits<float>::max());
+		minZ.push_back(std::numeric_limits<float>::max());
+		maxX.push_back(std::numeric_limits<float>::lowest());
+		maxY.push_back(std::numeric_limits<float>::lowest());
+		maxZ.push_back(std::numeric_limits<float>::lowest());
+	}
+}
+
+void BoxArrays::push(const Aabb& box) {
+	minX.push_back(box.min.x);
+	minY.push_back(box.min.y);
+	minZ.push_back(box.min.z);
+	maxX.push_back(box.max.x);
+	maxY.push_back(box.max.y);
+	maxZ.push_back(box.max.z);
+}
+
+uint32_t ClusterKernel::intersectSphere(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits) {
+	return intersectSphere(sphere, boxes, begin, end, hits, getBestPath());
+}
+
+uint32_t ClusterKernel::intersectSphere(const glm::vec4& sphere, const BoxArrays& boxes, uint32_t begin, uint32_t end, uint32_t* hits, Path path) {
+	switch (path) {
+#if CLUSTER_X86
+	case Path::AVX2:
+		return intersectAVX2(sphere, boxes, begin, end, hits);
+	case Path::SSE:
+		return intersectSSE(sphere, boxes, begin, end, hits);
+#endif
+	default:
+		return intersectScalar(sphere, boxes, begin, end, hits);
+	}
+}
+
+bool ClusterKernel::isSupported(Path path) {
+	switch (path) {
+#if CLUSTER_X86
+	case Path::AVX2:
+		return Common::cpuSupportsAVX2();
+	case Path::SSE:
+		return true;
+#endif
+	case Path::Scalar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+ClusterKernel::Path ClusterKernel::getBestPath() {
+	static const Path best = isSupported(Path::AVX2) ? Path::AVX2 : isSupported(Path::SSE) ? Path::SSE : Path::Scalar;
+	return best;
+}
+
+const char* ClusterKernel::getPathName(Path path) {
+	switch (path) {
+	case Path::AVX2:
+		return "AVX2";
+	case Path::SSE:
+		return "SSE";
+	default:
+		return "Scalar";
+	}
+}
+
+}
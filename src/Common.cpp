@@ -1,5 +1,10 @@
 #include "Core/Common.hpp"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
@@ -24,4 +29,26 @@ std::vector<char> Common::readFile(const std::string& filepath) {
 	return buffer;
 }
 
+bool Common::cpuSupportsAVX2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 0);
+
+	if (info[0] < 7) return false;
+
+	// the os has to save the ymm registers as well
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+
+	if (!osxsave || (_xgetbv(0) & 6) != 6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "renderer/CullingKernel.hpp"
+
+#include "Core/Common.hpp"
+
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CULLING_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#endif
+
+namespace stl {
+
+namespace {
+
+using Planes = std::array<glm::vec4, Frustum::Count>;
+
+// same arithmetic order as the vector paths, so that all of them agree on every sphere
+uint32_t cullScalar(const Planes& planes, const SphereArrays& spheres, uint8_t* visibility, size_t begin, size_t end) {
+	uint32_t visibleCount = 0;
+
+	for (size_t i = begin; i < end; i++) {
+		bool visible = true;
+
+		for (const glm::vec4& plane : planes) {
+			float distance = plane.x * spheres.centerX[i] + plane.y * spheres.centerY[i] + plane.z * spheres.centerZ[i] + plane.w;
+
+			if (!(distance >= -spheres.radius[i])) {
+				visible = false;
+				break;
+			}
+		}
+
+		visibility[i] = visible ? 1 : 0;
+		visibleCount += visible ? 1 : 0;
+	}
+
+	return visibleCount;
+}
+
+#if CULLING_X86
+
+TARGET_SSE uint32_t cullSSE(const Planes& planes, const SphereArrays& spheres, uint8_t* visibility) {
+	size_t count = spheres.size();
+	size_t blockEnd = count & ~size_t(3);
+
+	__m128 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+
+	for (int p = 0; p < Frustum::Count; p++) {
+		planeX[p] = _mm_set1_ps(planes[p].x);
+		planeY[p] = _mm_set1_ps(planes[p].y);
+		planeZ[p] = _mm_set1_ps(planes[p].z);
+		planeW[p] = _mm_set1_ps(planes[p].w);
+	}
+
+	uint32_t visibleCount = 0;
+
+	for (size_t i = 0; i < blockEnd; i += 4) {
+		__m128 x = _mm_loadu_ps(&spheres.centerX[i]);
+		__m128 y = _mm_loadu_ps(&spheres.centerY[i]);
+		__m128 z = _mm_loadu_ps(&spheres.centerZ[i]);
+		__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.radius[i]));
+
+		__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (int p = 0; p < Frustum::Count; p++) {
+			__m128 distance = _mm_mul_ps(planeX[p], x);
+			distance = _mm_add_ps(distance, _mm_mul_ps(planeY[p], y));
+			distance = _mm_add_ps(distance, _mm_mul_ps(planeZ[p], z));
+			distance = _mm_add_ps(distance, planeW[p]);
+
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negRadius));
+		}
+
+		unsigned mask = static_cast<unsigned>(_mm_movemask_ps(visible));
+
+		for (int j = 0; j < 4; j++) {
+			visibility[i + j] = (mask >> j) & 1;
+		}
+
+		visibleCount += std::popcount(mask);
+	}
+
+	return visibleCount + cullScalar(planes, spheres, visibility, blockEnd, count);
+}
+
+TARGET_AVX2 uint32_t cullAVX2(const Planes& planes, const SphereArrays& spheres, uint8_t* visibility) {
+	size_t count = spheres.size();
+	size_t blockEnd = count & ~size_t(7);
+
+	__m256 planeX[Frustum::Count], planeY[Frustum::Count], planeZ[Frustum::Count], planeW[Frustum::Count];
+
+	for (int p = 0; p < Frustum::Count; p++) {
+		planeX[p] = _mm256_set1_ps(planes[p].x);
+		planeY[p] = _mm256_set1_ps(planes[p].y);
+		planeZ[p] = _mm256_set1_ps(planes[p].z);
+		planeW[p] = _mm256_set1_ps(planes[p].w);
+	}
+
+	uint32_t visibleCount = 0;
+
+	for (size_t i = 0; i < blockEnd; i += 8) {
+		__m256 x = _mm256_loadu_ps(&spheres.centerX[i]);
+		__m256 y = _mm256_loadu_ps(&spheres.centerY[i]);
+		__m256 z = _mm256_loadu_ps(&spheres.centerZ[i]);
+		__m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&spheres.radius[i]));
+
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (int p = 0; p < Frustum::Count; p++) {
+			__m256 distance = _mm256_mul_ps(planeX[p], x);
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(planeY[p], y));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(planeZ[p], z));
+			distance = _mm256_add_ps(distance, planeW[p]);
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+		}
+
+		unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(visible));
+
+		for (int j = 0; j < 8; j++) {
+			visibility[i + j] = (mask >> j) & 1;
+		}
+
+		visibleCount += std::popcount(mask);
+	}
+
+	return visibleCount + cullScalar(planes, spheres, visibility, blockEnd, count);
+}
+
+#endif
+
+}
+
+void SphereArrays::clear() {
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	radius.clear();
+}
+
+void SphereArrays::push(const glm::vec3& center, float sphereRadius) {
+	centerX.push_back(center.x);
+	centerY.push_back(center.y);
+	centerZ.push_back(center.z);
+	radius.push_back(sphereRadius);
+}
+
+uint32_t CullingKernel::cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visibility) {
+	return cullSpheres(frustum, spheres, visibility, getBestPath());
+}
+
+uint32_t CullingKernel::cullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visibility, Path path) {
+	const Planes& planes = frustum.getPlanes();
+
+	switch (path) {
+#if CULLING_X86
+	case Path::AVX2:
+		return cullAVX2(planes, spheres, visibility);
+	case Path::SSE:
+		return cullSSE(planes, spheres, visibility);
+#endif
+	default:
+		return cullScalar(planes, spheres, visibility, 0, spheres.size());
+	}
+}
+
+bool CullingKernel::isSupported(Path path) {
+	switch (path) {
+#if CULLING_X86
+	case Path::AVX2:
+		return Common::cpuSupportsAVX2();
+	case Path::SSE:
+		return true;
+#endif
+	case Path::Scalar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+CullingKernel::Path CullingKernel::getBestPath() {
+	static const Path best = isSupported(Path::AVX2) ? Path::AVX2 : isSupported(Path::SSE) ? Path::SSE : Path::Scalar;
+	return best;
+}
+
+const char* CullingKernel::getPathName(Path path) {
+	switch (path) {
+	case Path::AVX2:
+		return "AVX2";
+	case Path::SSE:
+		return "SSE";
+	default:
+		return "Scalar";
+	}
+}
+
+}
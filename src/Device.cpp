@@ -18,6 +18,7 @@ Device::Device(Window& window)
 
 Device::~Device() {
 	vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+	m_Allocator.reset();
 	vkDestroyDevice(m_Device, nullptr);
 
 	vkDestroySurfaceKHR(m_Instance.getInstance(), m_Surface, nullptr);
@@ -39,7 +40,7 @@ VkFormat Device::findSupportedFormat(const std::vector<VkFormat> &candidates, Vk
 	return m_PhysicalDevice->findSupportedFormat(candidates, tiling, features);
 }
 
-void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory) const {
+void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, Allocation &allocation) const {
 	VkBufferCreateInfo bufferInfo = {};
 	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 	bufferInfo.size = size;
@@ -53,16 +54,11 @@ void Device::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryP
 	VkMemoryRequirements memRequirements;
 	vkGetBufferMemoryRequirements(m_Device, buffer, &memRequirements);
 
-	VkMemoryAllocateInfo allocInfo = {};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+	allocation = m_Allocator->allocate(memRequirements, properties, true);
 
-	if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-		throw std::runtime_error("Failed to allocate buffer memory!");
+	if (vkBindBufferMemory(m_Device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to bind buffer memory!");
 	}
-
-	vkBindBufferMemory(m_Device, buffer, bufferMemory, 0);
 }
 
 VkCommandBuffer Device::beginSingleTimeCommands() const {
@@ -98,12 +94,12 @@ void Device::endSingleTimeCommands(VkCommandBuffer commandBuffer) const {
 	vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
 }
 
-void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) const {
+void Device::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset) const {
 	VkCommandBuffer commandBuffer = beginSingleTimeCommands();
 
 	VkBufferCopy copyRegion = {};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
+	copyRegion.srcOffset = srcOffset;
+	copyRegion.dstOffset = dstOffset;
 	copyRegion.size = size;
 
 	vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
@@ -130,7 +126,7 @@ void Device::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, u
 	endSingleTimeCommands(commandBuffer);
 }
 
-void Device::createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory) const {
+void Device::createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties, VkImage &image, Allocation &allocation) const {
 	if (vkCreateImage(m_Device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create image!");
 	}
@@ -138,16 +134,9 @@ void Device::createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPro
 	VkMemoryRequirements memRequirements;
 	vkGetImageMemoryRequirements(m_Device, image, &memRequirements);
 
-	VkMemoryAllocateInfo allocInfo = {};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-	if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-		throw std::runtime_error("Failed to allocate image memory!");
-	}
+	allocation = m_Allocator->allocate(memRequirements, properties, imageInfo.tiling == VK_IMAGE_TILING_LINEAR);
 
-	if (vkBindImageMemory(m_Device, image, imageMemory, 0) != VK_SUCCESS) {
+	if (vkBindImageMemory(m_Device, image, allocation.memory, allocation.offset) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to bind image memory!");
 	}
 }
@@ -158,6 +147,7 @@ void Device::createSurface() {
 
 void Device::pickPhysicalDevice() {
 	m_PhysicalDevice = std::make_shared<PhysicalDevice>(PhysicalDevice::suitableDevices(m_Instance, m_Surface)[0]);
+	p_Properties = m_PhysicalDevice->p_Properties;
 }
 
 void Device::createLogicalDevice() {
@@ -181,6 +171,10 @@ void Device::createLogicalDevice() {
 	VkPhysicalDeviceFeatures deviceFeatures = {};
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+	// optional, render systems fall back to regular draws without them
+	deviceFeatures.multiDrawIndirect = m_PhysicalDevice->p_Features.multiDrawIndirect;
+	deviceFeatures.drawIndirectFirstInstance = m_PhysicalDevice->p_Features.drawIndirectFirstInstance;
+
 	VkDeviceCreateInfo createInfo = {};
 	createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 	createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
@@ -194,8 +188,12 @@ void Device::createLogicalDevice() {
 		throw std::runtime_error("Failed to create logical device!");
 	}
 
+	p_Features = deviceFeatures;
+
 	vkGetDeviceQueue(m_Device, indices.graphicsFamily.value(), 0, &m_GraphicsQueue);
 	vkGetDeviceQueue(m_Device, indices.presentFamily.value(), 0, &m_PresentQueue);
+
+	m_Allocator = std::make_unique<MemoryAllocator>(m_Device, m_PhysicalDevice->getPhysicalDevice());
 }
 
 void Device::createCommandPool() {
@@ -3,7 +3,8 @@
 #include "Core/Logger.hpp"
 #include "Core/Asserts.hpp"
 #include "input/Input.hpp"
-#include "renderer/wrapper/Buffer.hpp"
+#include "renderer/FrameUniforms.hpp"
+#include "renderer/FrameAllocator.hpp"
 #include "Camera.hpp"
 #include "KeyboardMovementController.hpp"
 
@@ -26,17 +27,7 @@ FirstApp::~FirstApp() {
 }
 
 void FirstApp::run() {
-	std::vector<std::unique_ptr<Buffer>> uboBuffers(Swapchain::MAX_FRAMES_IN_FLIGHT);
-
-	for (int i = 0; i < uboBuffers.size(); i++) {
-		uboBuffers[i] = std::make_unique<Buffer>(m_Device,
-			sizeof(GlobalUbo),
-			Swapchain::MAX_FRAMES_IN_FLIGHT,
-			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
-
-		uboBuffers[i]->map();
-	}
+	FrameUniforms frameUniforms{ m_Device };
 
 	auto globalSetLayout = DescriptorSetLayout::Builder(m_Device)
 		.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_ALL_GRAPHICS)
@@ -45,39 +36,59 @@ void FirstApp::run() {
 	std::vector<VkDescriptorSet> globalDescriptorSets(Swapchain::MAX_FRAMES_IN_FLIGHT);
 
 	for (int i = 0; i < globalDescriptorSets.size(); i++) {
-		auto bufferInfo = uboBuffers[i]->descriptorInfo();
+		auto bufferInfo = frameUniforms.descriptorInfo(i);
 
 		DescriptorWriter(*globalSetLayout, *m_GlobalPool)
 			.writeBuffer(0, &bufferInfo)
 			.build(globalDescriptorSets[i]);
 	}
 
-	SimpleRenderSystem simpleRenderSystem{ m_Device, m_Renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout() };
-	PointLightSystem pointLightSystem{ m_Device, m_Renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout() };
+	FrameAllocator frameAllocator{ m_Device };
+	PointLightSystem pointLightSystem{ m_Device, m_Renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout(), frameAllocator };
+	SimpleRenderSystem simpleRenderSystem{ m_Device, m_Renderer.getSwapchainRenderPass(), globalSetLayout->getDescriptorSetLayout(), pointLightSystem.getLightSetLayout(), frameAllocator };
+	FrustumCuller frustumCuller{};
 	Camera camera{};
 
-	GameObject viewerObject = GameObject::createGameObject();
-	viewerObject.p_Transform.translation = { 0.0f, 0.0f, 2.5f };
+	GameObject viewerObject = m_Scene.createGameObject();
+	viewerObject.getTransform().setTranslation({ 0.0f, 0.0f, 2.5f });
 	KeyboardMovementController cameraController{};
 
 	auto currentTime = std::chrono::high_resolution_clock::now();
 
 	while (!m_Window.shouldClose()) {
 		glfwPollEvents();
+		m_ModelLoader.update();
 
 		auto newTime = std::chrono::high_resolution_clock::now();
 		float dt = std::chrono::duration<float, std::chrono::seconds::period>(newTime - currentTime).count();
 		currentTime = newTime;
 
 		cameraController.moveInPlaneXZ(dt, viewerObject);
-		camera.setViewYXZ(viewerObject.p_Transform.translation, viewerObject.p_Transform.rotation);
+		camera.setViewYXZ(viewerObject.getTransform().getTranslation(), viewerObject.getTransform().getRotation());
 
 		float aspect = m_Renderer.getAspectRatio();
 		camera.setPerspectiveProjection(glm::radians(50.0f), aspect, 0.1f, 100.0f);
 
 		if (VkCommandBuffer commandBuffer = m_Renderer.beginFrame()) {
+			m_Scene.updateTransforms();
+			frustumCuller.cull(camera, m_Scene);
+
 			int frameIndex = m_Renderer.getFrameIndex();
-			FrameInfo frameInfo{ frameIndex, dt, commandBuffer, camera, globalDescriptorSets[frameIndex], m_GameObjects };
+			frameAllocator.beginFrame(frameIndex);
+			m_GeometryPool.beginFrame(frameIndex);
+
+			FrameInfo frameInfo{
+				frameIndex,
+				dt,
+				commandBuffer,
+				m_Renderer.getSwapchainExtent(),
+				camera,
+				globalDescriptorSets[frameIndex],
+				pointLightSystem.getLightDescriptorSet(frameIndex),
+				m_Scene,
+				frustumCuller.getVisibleObjects(),
+				frustumCuller.getVisibleLights()
+			};
 
 			// update
 			GlobalUbo ubo{};
@@ -85,8 +96,7 @@ void FirstApp::run() {
 			ubo.view = camera.getView();
 			ubo.inverseView = camera.getInverseView();
 			pointLightSystem.update(frameInfo, ubo);
-			uboBuffers[frameIndex]->writeToBuffer(&ubo);
-			uboBuffers[frameIndex]->flush();
+			frameUniforms.update(frameIndex, ubo);
 
 			// render
 			m_Renderer.beginSwapchainRenderPass(commandBuffer);
@@ -95,6 +105,8 @@ void FirstApp::run() {
 			pointLightSystem.render(frameInfo);
 
 			m_Renderer.endSwapchainRenderPass(commandBuffer);
+
+			frameAllocator.flush();
 			m_Renderer.endFrame();
 		}
 	}
@@ -103,32 +115,31 @@ void FirstApp::run() {
 }
 
 void FirstApp::loadGameObjects() {
-	std::shared_ptr<Model> flatVaseModel = Model::createModelFromFile(m_Device, "assets/models/flat_vase.obj");
-
-	GameObject flatVase = GameObject::createGameObject();
-	flatVase.p_Model = flatVaseModel;
-	flatVase.p_Transform.translation = { -0.5f, -0.5f, 0.0f };
-	flatVase.p_Transform.scale = { 3.0f, -1.5f, 3.0f }; // negative y scale bc y axis of model is flipped
-	m_GameObjects.emplace(flatVase.getId(), std::move(flatVase));
-
-	std::shared_ptr<Model> smoothVaseModel = Model::createModelFromFile(m_Device, "assets/models/smooth_vase.obj");
+	// models are assigned once they have finished loading, until then the objects are simply not drawn
+	auto assignModel = [this](GameObject::id_t id) {
+		return [this, id](std::shared_ptr<Model> model) {
+			if (m_Scene.isAlive(id)) {
+				m_Scene.getGameObject(id).setModel(model);
+			}
+		};
+	};
 
-	GameObject smoothVase = GameObject::createGameObject();
-	smoothVase.p_Model = smoothVaseModel;
-	smoothVase.p_Transform.translation = { 0.5f, -0.5f, 0.0f };
-	smoothVase.p_Transform.scale = { 3.0f, -1.5f, 3.0f };
-	m_GameObjects.emplace(smoothVase.getId(), std::move(smoothVase));
+	GameObject flatVase = m_Scene.createGameObject();
+	m_ModelLoader.load("assets/models/flat_vase.obj", assignModel(flatVase.getId()));
+	flatVase.getTransform().setTranslation({ -0.5f, -0.5f, 0.0f });
+	flatVase.getTransform().setScale({ 3.0f, -1.5f, 3.0f }); // negative y scale bc y axis of model is flipped
 
-	std::shared_ptr<Model> floorModel = Model::createModelFromFile(m_Device, "assets/models/quad.obj");
+	GameObject smoothVase = m_Scene.createGameObject();
+	m_ModelLoader.load("assets/models/smooth_vase.obj", assignModel(smoothVase.getId()));
+	smoothVase.getTransform().setTranslation({ 0.5f, -0.5f, 0.0f });
+	smoothVase.getTransform().setScale({ 3.0f, -1.5f, 3.0f });
 
-	GameObject floor = GameObject::createGameObject();
-	floor.p_Model = floorModel;
-	floor.p_Transform.translation = { 0.0f, -0.5f, 0.0f };
-	floor.p_Transform.scale = { 3.0f, 1.0f, 3.0f };
-	m_GameObjects.emplace(floor.getId(), std::move(floor));
+	GameObject floor = m_Scene.createGameObject();
+	m_ModelLoader.load("assets/models/quad.obj", assignModel(floor.getId()));
+	floor.getTransform().setTranslation({ 0.0f, -0.5f, 0.0f });
+	floor.getTransform().setScale({ 3.0f, 1.0f, 3.0f });
 
-	GameObject pointLight = GameObject::createPointLight(0.2f);
-	m_GameObjects.emplace(pointLight.getId(), std::move(pointLight));
+	m_Scene.createPointLight(0.2f);
 
 	std::vector<glm::vec3> lightColors{
 		{1.f, .1f, .1f},
@@ -140,11 +151,10 @@ void FirstApp::loadGameObjects() {
 	};
 
 	for (int i = 0; i < lightColors.size(); i++) {
-		GameObject light = GameObject::createPointLight(0.2f);
-		light.p_Color = lightColors[i];
+		GameObject light = m_Scene.createPointLight(0.2f);
+		light.getPointLight()->color = lightColors[i];
 		glm::mat4 rotateLight = glm::rotate(glm::mat4(1.0f), (i * glm::two_pi<float>()) / lightColors.size(), { 0.0f, 1.0f, 0.0f });
-		light.p_Transform.translation = glm::vec3(rotateLight * glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-		m_GameObjects.emplace(light.getId(), std::move(light));
+		light.getTransform().setTranslation(glm::vec3(rotateLight * glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)));
 	}
 }
 
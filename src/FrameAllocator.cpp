@@ -0,0 +1,160 @@
+#include "renderer/FrameAllocator.hpp"
+
+#include "Core/Asserts.hpp"
+#include "renderer/wrapper/Swapchain.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace stl {
+
+FrameAllocator::FrameAllocator(Device& device, VkDeviceSize frameSize, VkDeviceSize bindingRange)
+	: m_Device{ device } {
+	const VkPhysicalDeviceLimits& limits = m_Device.p_Properties.limits;
+
+	m_UniformAlignment = std::max<VkDeviceSize>(limits.minUniformBufferOffsetAlignment, 1);
+	m_StorageAlignment = std::max<VkDeviceSize>(limits.minStorageBufferOffsetAlignment, 1);
+
+	// every buffer is sized for any kind of allocation to end at its end
+	m_BlockAlignment = std::max(m_UniformAlignment, m_StorageAlignment);
+	frameSize = (frameSize + m_BlockAlignment - 1) / m_BlockAlignment * m_BlockAlignment;
+
+	// a wider range than the initial buffer would mostly grow the tail
+	m_BindingRange = std::min({ bindingRange, frameSize, static_cast<VkDeviceSize>(limits.maxStorageBufferRange) });
+
+	m_StorageSetLayout = DescriptorSetLayout::Builder(m_Device)
+		.addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_ALL_GRAPHICS)
+		.build();
+
+	// sets of outgrown buffers are freed again once their frame comes around
+	m_DescriptorPool = DescriptorPool::Builder(m_Device)
+		.setMaxSets(MAX_BLOCKS)
+		.addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, MAX_BLOCKS)
+		.setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
+		.build();
+
+	m_Frames.resize(Swapchain::MAX_FRAMES_IN_FLIGHT);
+
+	for (Frame& frame : m_Frames) {
+		frame.current = createBlock(frameSize);
+	}
+}
+
+void FrameAllocator::beginFrame(int frameIndex) {
+	m_FrameIndex = frameIndex;
+
+	Frame& frame = m_Frames[m_FrameIndex];
+
+	// a frame that outgrew its buffer gets one that holds everything it used, so it allocates from a single buffer again
+	if (!frame.retired.empty()) {
+		VkDeviceSize used = getUsedBytes();
+		VkDeviceSize blockSize = frame.current.size;
+
+		while (blockSize < used) {
+			blockSize *= 2;
+		}
+
+		frame.retired.push_back(std::move(frame.current));
+		frame.current = createBlock(blockSize);
+	}
+
+	freeBlocks(frame.retired);
+	frame.current.used = 0;
+}
+
+FrameAllocation FrameAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+	SASSERT_MSG(alignment > 0 && (alignment & (alignment - 1)) == 0, "Frame allocations need a power of two alignment!");
+
+	Frame& frame = m_Frames[m_FrameIndex];
+	VkDeviceSize offset = (frame.current.used + alignment - 1) & ~(alignment - 1);
+
+	if (offset + size > frame.current.size) {
+		// earlier allocations of this frame stay where they are
+		VkDeviceSize blockSize = std::max(frame.current.size * 2, (size + m_BlockAlignment - 1) / m_BlockAlignment * m_BlockAlignment);
+
+		frame.retired.push_back(std::move(frame.current));
+		frame.current = createBlock(blockSize);
+
+		offset = 0;
+	}
+
+	Block& block = frame.current;
+	block.used = offset + size;
+
+	return FrameAllocation{ static_cast<char*>(block.buffer->getMappedMemory()) + offset, block.buffer->getBuffer(), block.storageSet, offset, size };
+}
+
+FrameAllocation FrameAllocator::allocateStorage(VkDeviceSize size) {
+	if (size > m_BindingRange) {
+		throw std::runtime_error("Frame storage allocation exceeds the binding range!");
+	}
+
+	FrameAllocation allocation = allocate(size, m_StorageAlignment);
+
+	SASSERT_MSG(allocation.offset + m_BindingRange <= m_Frames[m_FrameIndex].current.buffer->getBufferSize(), "Binding range of a storage allocation reaches past the buffer!");
+
+	return allocation;
+}
+
+void FrameAllocator::flush() {
+	Frame& frame = m_Frames[m_FrameIndex];
+
+	for (Block& block : frame.retired) {
+		block.buffer->flush(block.used, 0);
+	}
+
+	if (frame.current.used > 0) {
+		frame.current.buffer->flush(frame.current.used, 0);
+	}
+}
+
+VkDeviceSize FrameAllocator::getUsedBytes() const {
+	const Frame& frame = m_Frames[m_FrameIndex];
+	VkDeviceSize used = frame.current.used;
+
+	for (const Block& block : frame.retired) {
+		used += block.used;
+	}
+
+	return used;
+}
+
+FrameAllocator::Block FrameAllocator::createBlock(VkDeviceSize size) {
+	Block block{};
+	block.size = size;
+	block.buffer = std::make_unique<Buffer>(m_Device,
+		size + m_BindingRange,
+		1,
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+	if (block.buffer->map() != VK_SUCCESS) {
+		throw std::runtime_error("Failed to map frame allocator buffer!");
+	}
+
+	// dynamic descriptors read the binding range from their dynamic offset
+	auto bufferInfo = block.buffer->descriptorInfo(m_BindingRange, 0);
+
+	if (!DescriptorWriter(*m_StorageSetLayout, *m_DescriptorPool).writeBuffer(0, &bufferInfo).build(block.storageSet)) {
+		throw std::runtime_error("Failed to allocate frame allocator descriptor set!");
+	}
+
+	return block;
+}
+
+void FrameAllocator::freeBlocks(std::vector<Block>& blocks) {
+	if (blocks.empty()) {
+		return;
+	}
+
+	std::vector<VkDescriptorSet> descriptorSets;
+
+	for (const Block& block : blocks) {
+		descriptorSets.push_back(block.storageSet);
+	}
+
+	m_DescriptorPool->freeDescriptors(descriptorSets);
+	blocks.clear();
+}
+
+}
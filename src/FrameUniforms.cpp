@@ -0,0 +1,78 @@
+#include "renderer/FrameUniforms.hpp"
+
+#include "renderer/wrapper/Swapchain.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+namespace stl {
+
+namespace {
+
+// fields that are compared and uploaded on their own, the camera moves every frame while the rest rarely changes
+constexpr std::array<std::pair<size_t, size_t>, 7> UBO_FIELDS{ {
+	{ offsetof(GlobalUbo, projection), sizeof(GlobalUbo::projection) },
+	{ offsetof(GlobalUbo, view), sizeof(GlobalUbo::view) },
+	{ offsetof(GlobalUbo, inverseView), sizeof(GlobalUbo::inverseView) },
+	{ offsetof(GlobalUbo, ambientLightColor), sizeof(GlobalUbo::ambientLightColor) },
+	{ offsetof(GlobalUbo, clusterScale), sizeof(GlobalUbo::clusterScale) },
+	{ offsetof(GlobalUbo, clusterGridSize), sizeof(GlobalUbo::clusterGridSize) },
+	{ offsetof(GlobalUbo, numLights), sizeof(GlobalUbo::numLights) }
+} };
+
+}
+
+FrameUniforms::FrameUniforms(Device& device)
+	: m_Device{ device }, m_AtomSize{ device.getAllocator().getNonCoherentAtomSize() } {
+	m_Frames.resize(Swapchain::MAX_FRAMES_IN_FLIGHT);
+
+	for (FrameResources& frame : m_Frames) {
+		frame.buffer = std::make_unique<Buffer>(m_Device,
+			sizeof(GlobalUbo),
+			1,
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		frame.buffer->map();
+	}
+}
+
+void FrameUniforms::update(int frameIndex, const GlobalUbo& ubo) {
+	FrameResources& frame = m_Frames[frameIndex];
+
+	const char* source = reinterpret_cast<const char*>(&ubo);
+	char* contents = reinterpret_cast<char*>(&frame.contents);
+
+	m_Stats = {};
+	m_DirtyRanges.clear();
+
+	for (const auto& [offset, size] : UBO_FIELDS) {
+		if (frame.written && std::memcmp(contents + offset, source + offset, size) == 0) continue;
+
+		std::memcpy(contents + offset, source + offset, size);
+		frame.buffer->writeToBuffer(source + offset, size, offset);
+		m_Stats.writtenBytes += size;
+
+		// mapped allocations start on an atom and are padded to whole atoms, so aligning within the buffer aligns in memory as well
+		VkDeviceSize begin = offset / m_AtomSize * m_AtomSize;
+		VkDeviceSize end = (offset + size + m_AtomSize - 1) / m_AtomSize * m_AtomSize;
+
+		// the fields are in order, neighbours sharing an atom are flushed together
+		if (!m_DirtyRanges.empty() && m_DirtyRanges.back().offset + m_DirtyRanges.back().size >= begin) {
+			m_DirtyRanges.back().size = end - m_DirtyRanges.back().offset;
+		} else {
+			m_DirtyRanges.push_back({ begin, end - begin });
+		}
+	}
+
+	frame.written = true;
+
+	for (const Range& range : m_DirtyRanges) {
+		frame.buffer->flush(range.size, range.offset);
+		m_Stats.flushedBytes += range.size;
+	}
+}
+
+}
@@ -0,0 +1,54 @@
+#include "renderer/Frustum.hpp"
+
+namespace stl {
+
+Frustum::Frustum(const glm::mat4& viewProjection) {
+	auto row = [&](int i) {
+		return glm::vec4{ viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+	};
+
+	glm::vec4 r0 = row(0);
+	glm::vec4 r1 = row(1);
+	glm::vec4 r2 = row(2);
+	glm::vec4 r3 = row(3);
+
+	m_Planes[Left] = r3 + r0;
+	m_Planes[Right] = r3 - r0;
+	m_Planes[Bottom] = r3 + r1;
+	m_Planes[Top] = r3 - r1;
+	m_Planes[Near] = r2; // depth range is [0, 1]
+	m_Planes[Far] = r3 - r2;
+
+	for (glm::vec4& plane : m_Planes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+	for (const glm::vec4& plane : m_Planes) {
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Frustum::intersectsBox(const glm::vec3& min, const glm::vec3& max) const {
+	for (const glm::vec4& plane : m_Planes) {
+		// corner furthest along the plane normal
+		glm::vec3 positive{
+			plane.x >= 0.0f ? max.x : min.x,
+			plane.y >= 0.0f ? max.y : min.y,
+			plane.z >= 0.0f ? max.z : min.z
+		};
+
+		if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,154 @@
+#include "renderer/FrustumCuller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace stl {
+
+void FrustumCuller::cull(const Camera& camera, const Scene& scene) {
+	m_Frustum = Frustum{ camera.getProjection() * camera.getView() };
+
+	gatherObjects(scene);
+
+	m_QueryItems.clear();
+	m_Hierarchy.queryFrustum(m_Frustum, m_QueryItems);
+
+	m_QuerySpheres.clear();
+
+	for (uint32_t item : m_QueryItems) {
+		m_QuerySpheres.push(glm::vec3(m_Spheres[item]), m_Spheres[item].w);
+	}
+
+	m_Visibility.resize(m_QueryItems.size());
+
+	uint32_t visibleCount = CullingKernel::cullSpheres(m_Frustum, m_QuerySpheres, m_Visibility.data());
+
+	m_VisibleObjects.clear();
+	m_VisibleLights.clear();
+
+	for (size_t i = 0; i < m_QueryItems.size(); i++) {
+		if (!m_Visibility[i]) continue;
+
+		GameObject::id_t id = m_Objects[m_QueryItems[i]];
+
+		if (scene.getModels().contains(id)) m_VisibleObjects.push_back(id);
+		if (scene.getPointLights().contains(id)) m_VisibleLights.push_back(id);
+	}
+
+	m_Stats.visibleCount = visibleCount;
+	m_Stats.culledCount = static_cast<uint32_t>(m_Objects.size()) - visibleCount;
+}
+
+std::optional<GameObject::id_t> FrustumCuller::pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+	auto hit = m_Hierarchy.raycast(origin, direction, maxDistance);
+
+	if (!hit) return std::nullopt;
+
+	return m_Objects[hit->item];
+}
+
+void FrustumCuller::queryObjects(const glm::vec3& center, float radius, std::vector<GameObject::id_t>& result) const {
+	std::vector<uint32_t> items;
+	m_Hierarchy.querySphere(center, radius, items);
+
+	for (uint32_t item : items) {
+		result.push_back(m_Objects[item]);
+	}
+}
+
+void FrustumCuller::gatherObjects(const Scene& scene) {
+	const auto& models = scene.getModels();
+	const auto& lights = scene.getPointLights();
+
+	// the items only change when models or lights are added, replaced or removed, moving them is handled by a refit
+	if (models.getVersion() != m_ModelsVersion || lights.getVersion() != m_LightsVersion) {
+		m_Objects.assign(models.getIds().begin(), models.getIds().end());
+
+		for (GameObject::id_t id : lights.getIds()) {
+			if (!models.contains(id)) m_Objects.push_back(id);
+		}
+
+		m_Boxes.resize(m_Objects.size());
+		m_Spheres.resize(m_Objects.size());
+		m_Items.clear();
+
+		for (uint32_t item = 0; item < m_Objects.size(); item++) {
+			m_Items.add(m_Objects[item], item);
+			updateBounds(scene, item);
+		}
+
+		m_Hierarchy.build(m_Boxes);
+
+		m_ModelsVersion = models.getVersion();
+		m_LightsVersion = lights.getVersion();
+		m_TransformUpdateCount = scene.getTransformUpdateCount();
+		return;
+	}
+
+	uint64_t updateCount = scene.getTransformUpdateCount();
+
+	if (updateCount == m_TransformUpdateCount + 1) {
+		for (GameObject::id_t id : scene.getUpdatedTransforms()) {
+			const uint32_t* item = m_Items.tryGet(id);
+
+			if (item != nullptr && updateBounds(scene, *item)) {
+				m_Hierarchy.update(*item, m_Boxes[*item]);
+			}
+		}
+	} else if (updateCount != m_TransformUpdateCount) {
+		// an update was missed, so any object may have moved
+		for (uint32_t item = 0; item < m_Objects.size(); item++) {
+			if (updateBounds(scene, item)) {
+				m_Hierarchy.update(item, m_Boxes[item]);
+			}
+		}
+	}
+
+	m_TransformUpdateCount = updateCount;
+	m_Hierarchy.refit();
+}
+
+bool FrustumCuller::updateBounds(const Scene& scene, uint32_t item) {
+	const TransformComponent& transform = scene.getTransforms().get(m_Objects[item]);
+	const ModelComponent* model = scene.getModels().tryGet(m_Objects[item]);
+
+	Aabb box;
+	glm::vec4 sphere;
+
+	if (model != nullptr && model->model != nullptr) {
+		const Bounds& bounds = model->model->getBounds();
+		const glm::mat4& modelMatrix = transform.getWorldMatrix();
+
+		// rotation keeps the radius, non-uniform scale is covered by its largest axis
+		float maxScaleSquared = std::max({ glm::dot(glm::vec3(modelMatrix[0]), glm::vec3(modelMatrix[0])),
+			glm::dot(glm::vec3(modelMatrix[1]), glm::vec3(modelMatrix[1])),
+			glm::dot(glm::vec3(modelMatrix[2]), glm::vec3(modelMatrix[2])) });
+
+		glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(bounds.center, 1.0f));
+		float radius = bounds.radius * std::sqrt(maxScaleSquared);
+
+		// the box of a transformed box, its extent is projected onto each world axis
+		glm::vec3 boxCenter = glm::vec3(modelMatrix * glm::vec4((bounds.min + bounds.max) * 0.5f, 1.0f));
+		glm::vec3 extent = (bounds.max - bounds.min) * 0.5f;
+		glm::vec3 worldExtent = glm::abs(glm::vec3(modelMatrix[0])) * extent.x + glm::abs(glm::vec3(modelMatrix[1])) * extent.y + glm::abs(glm::vec3(modelMatrix[2])) * extent.z;
+
+		box = Aabb{ boxCenter - worldExtent, boxCenter + worldExtent };
+		sphere = glm::vec4(center, radius);
+	} else {
+		// point lights are drawn as billboards with the x scale as radius
+		float radius = transform.getScale().x;
+		glm::vec3 position = transform.getWorldPosition();
+
+		box = Aabb{ position - glm::vec3(radius), position + glm::vec3(radius) };
+		sphere = glm::vec4(position, radius);
+	}
+
+	bool changed = box.min != m_Boxes[item].min || box.max != m_Boxes[item].max;
+
+	m_Boxes[item] = box;
+	m_Spheres[item] = sphere;
+
+	return changed;
+}
+
+}
@@ -1,66 +1,166 @@
 #include "GameObject.hpp"
 
+#include "Scene.hpp"
+
 namespace stl {
 
-GameObject GameObject::createGameObject() {
-	static id_t currentId = 0;
-	return GameObject{ currentId++ };
+GameObject::GameObject(Scene& scene, id_t objectId)
+	: m_Scene{ &scene }, m_Id{ objectId } {
+}
+
+bool GameObject::isValid() const {
+	return m_Scene->isAlive(m_Id);
+}
+
+TransformComponent& GameObject::getTransform() const {
+	return m_Scene->getTransforms().get(m_Id);
+}
+
+ModelComponent* GameObject::getModel() const {
+	return m_Scene->getModels().tryGet(m_Id);
+}
+
+PointLightComponent* GameObject::getPointLight() const {
+	return m_Scene->getPointLights().tryGet(m_Id);
+}
+
+void GameObject::setModel(std::shared_ptr<Model> model) const {
+	m_Scene->getModels().add(m_Id, std::move(model));
+}
+
+void GameObject::setParent(const GameObject& parent) const {
+	m_Scene->setParent(m_Id, parent.getId());
+}
+
+void TransformComponent::setTranslation(const glm::vec3& translation) {
+	if (translation == m_Translation) return;
+
+	m_Translation = translation;
+	m_Dirty = true;
+	m_Changed = true;
 }
 
-GameObject GameObject::createPointLight(float intensity, float radius, glm::vec3 color) {
-	GameObject obj = GameObject::createGameObject();
-	obj.p_Color = color;
-	obj.p_Transform.scale.x = radius;
-	obj.p_PointLight.emplace();
-	obj.p_PointLight->lightIntensity = intensity;
+void TransformComponent::setRotation(const glm::vec3& rotation) {
+	if (m_RotationMode == RotationMode::EulerYXZ && rotation == m_Rotation) return;
 
-	return obj;
+	m_Rotation = rotation;
+	m_RotationMode = RotationMode::EulerYXZ;
+	m_Dirty = true;
+	m_Changed = true;
 }
 
-GameObject::GameObject(id_t objectId)
-	: m_Id{ objectId } {
+void TransformComponent::setOrientation(const glm::quat& orientation) {
+	if (m_RotationMode == RotationMode::Quaternion && orientation == m_Orientation) return;
+
+	m_Orientation = orientation;
+	m_RotationMode = RotationMode::Quaternion;
+	m_Dirty = true;
+	m_Changed = true;
+}
+
+glm::vec3 TransformComponent::getRotation() const {
+	return m_RotationMode == RotationMode::EulerYXZ ? m_Rotation : Rotation::toEulerYXZ(m_Orientation);
+}
+
+glm::quat TransformComponent::getOrientation() const {
+	return m_RotationMode == RotationMode::Quaternion ? m_Orientation : Rotation::fromEulerYXZ(m_Rotation);
+}
+
+void TransformComponent::setScale(const glm::vec3& scale) {
+	if (scale == m_Scale) return;
+
+	m_Scale = scale;
+	m_Dirty = true;
+	m_Changed = true;
+}
+
+void TransformComponent::updateMatrices() const {
+	if (!m_Dirty) return;
+
+	// both matrices share the rotation, only the scale of the columns differs
+	const glm::mat3 rotation = m_RotationMode == RotationMode::Quaternion ? glm::mat3_cast(m_Orientation) : Rotation::toMatrixYXZ(m_Rotation);
+	const glm::vec3 invScale = 1.0f / m_Scale;
+
+	m_ModelMatrix = glm::mat4{
+		glm::vec4(m_Scale.x * rotation[0], 0.0f),
+		glm::vec4(m_Scale.y * rotation[1], 0.0f),
+		glm::vec4(m_Scale.z * rotation[2], 0.0f),
+		glm::vec4(m_Translation, 1.0f)
+	};
+
+	m_NormalMatrix = glm::mat3{ invScale.x * rotation[0], invScale.y * rotation[1], invScale.z * rotation[2] };
+
+	m_Dirty = false;
+}
+
+const glm::mat4& TransformComponent::getModelMatrix() const {
+	updateMatrices();
+	return m_ModelMatrix;
+}
+
+const glm::mat3& TransformComponent::getNormalMatrix() const {
+	updateMatrices();
+	return m_NormalMatrix;
 }
 
 glm::mat4 TransformComponent::modelMatrix() const {
-	const float c3 = glm::cos(rotation.z);
-	const float s3 = glm::sin(rotation.z);
-	const float c2 = glm::cos(rotation.x);
-	const float s2 = glm::sin(rotation.x);
-	const float c1 = glm::cos(rotation.y);
-	const float s1 = glm::sin(rotation.y);
+	if (m_RotationMode == RotationMode::Quaternion) {
+		const glm::mat3 rotation = glm::mat3_cast(m_Orientation);
+
+		return glm::mat4{
+			glm::vec4(m_Scale.x * rotation[0], 0.0f),
+			glm::vec4(m_Scale.y * rotation[1], 0.0f),
+			glm::vec4(m_Scale.z * rotation[2], 0.0f),
+			glm::vec4(m_Translation, 1.0f)
+		};
+	}
+
+	const float c3 = glm::cos(m_Rotation.z);
+	const float s3 = glm::sin(m_Rotation.z);
+	const float c2 = glm::cos(m_Rotation.x);
+	const float s2 = glm::sin(m_Rotation.x);
+	const float c1 = glm::cos(m_Rotation.y);
+	const float s1 = glm::sin(m_Rotation.y);
 
 	return glm::mat4{
 		{
-			scale.x * (c1 * c3 + s1 * s2 * s3),
-			scale.x * (c2 * s3),
-			scale.x * (c1 * s2 * s3 - c3 * s1),
+			m_Scale.x * (c1 * c3 + s1 * s2 * s3),
+			m_Scale.x * (c2 * s3),
+			m_Scale.x * (c1 * s2 * s3 - c3 * s1),
 			0.0f
 		},
 		{
-			scale.y * (c3 * s1 * s2 - c1 * s3),
-			scale.y * (c2 * c3),
-			scale.y * (c1 * c3 * s2 + s1 * s3),
+			m_Scale.y * (c3 * s1 * s2 - c1 * s3),
+			m_Scale.y * (c2 * c3),
+			m_Scale.y * (c1 * c3 * s2 + s1 * s3),
 			0.0f
 		},
 		{
-			scale.z * (c2 * s1),
-			scale.z * (-s2),
-			scale.z * (c1 * c2),
+			m_Scale.z * (c2 * s1),
+			m_Scale.z * (-s2),
+			m_Scale.z * (c1 * c2),
 			0.0f
 		},
-		{ translation.x, translation.y, translation.z, 1.0f }
+		{ m_Translation.x, m_Translation.y, m_Translation.z, 1.0f }
 	};
 
 }
 
 glm::mat3 TransformComponent::normalMatrix() const {
-	const float c3 = glm::cos(rotation.z);
-	const float s3 = glm::sin(rotation.z);
-	const float c2 = glm::cos(rotation.x);
-	const float s2 = glm::sin(rotation.x);
-	const float c1 = glm::cos(rotation.y);
-	const float s1 = glm::sin(rotation.y);
-	const glm::vec3 invScale = 1.0f / scale;
+	if (m_RotationMode == RotationMode::Quaternion) {
+		const glm::mat3 rotation = glm::mat3_cast(m_Orientation);
+		const glm::vec3 invScale = 1.0f / m_Scale;
+
+		return glm::mat3{ invScale.x * rotation[0], invScale.y * rotation[1], invScale.z * rotation[2] };
+	}
+
+	const float c3 = glm::cos(m_Rotation.z);
+	const float s3 = glm::sin(m_Rotation.z);
+	const float c2 = glm::cos(m_Rotation.x);
+	const float s2 = glm::sin(m_Rotation.x);
+	const float c1 = glm::cos(m_Rotation.y);
+	const float s1 = glm::sin(m_Rotation.y);
+	const glm::vec3 invScale = 1.0f / m_Scale;
 
 	return glm::mat3{
 		{
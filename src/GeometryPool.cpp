@@ -0,0 +1,102 @@
+#include "renderer/GeometryPool.hpp"
+
+#include "Core/Logger.hpp"
+#include "renderer/wrapper/Swapchain.hpp"
+
+#include <stdexcept>
+
+namespace stl {
+
+GeometryPool::GeometryPool(Device& device, uint32_t vertexCapacity, uint32_t indexCapacity)
+	: m_Device{ device }, m_VertexRanges{ vertexCapacity }, m_IndexRanges{ indexCapacity }, m_Transfer{ device } {
+	m_VertexBuffer = std::make_unique<Buffer>(m_Device,
+		sizeof(Model::Vertex),
+		vertexCapacity,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	m_IndexBuffer = std::make_unique<Buffer>(m_Device,
+		sizeof(uint32_t),
+		indexCapacity,
+		VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	m_PendingFrees.resize(Swapchain::MAX_FRAMES_IN_FLIGHT);
+}
+
+GeometryPool::~GeometryPool() {
+	// the pool is only destroyed once the device is idle
+	for (PendingFrees& frees : m_PendingFrees) {
+		release(frees);
+	}
+
+	if (!m_VertexRanges.isEmpty() || !m_IndexRanges.isEmpty()) {
+		SWARN("Destroying geometry pool with ", getUsedVertexCount(), " vertices and ", getUsedIndexCount(), " indices still in use");
+	}
+}
+
+uint32_t GeometryPool::allocateVertices(const std::vector<Model::Vertex>& vertices, TransferContext& transfer) {
+	auto firstVertex = m_VertexRanges.allocate(vertices.size());
+
+	if (!firstVertex) {
+		throw std::runtime_error("Failed to allocate vertices from geometry pool!");
+	}
+
+	transfer.upload(m_VertexBuffer->getBuffer(), vertices.data(), vertices.size() * sizeof(Model::Vertex), *firstVertex * sizeof(Model::Vertex));
+
+	return static_cast<uint32_t>(*firstVertex);
+}
+
+uint32_t GeometryPool::allocateIndices(const std::vector<uint32_t>& indices, TransferContext& transfer) {
+	auto firstIndex = m_IndexRanges.allocate(indices.size());
+
+	if (!firstIndex) {
+		throw std::runtime_error("Failed to allocate indices from geometry pool!");
+	}
+
+	transfer.upload(m_IndexBuffer->getBuffer(), indices.data(), indices.size() * sizeof(uint32_t), *firstIndex * sizeof(uint32_t));
+
+	return static_cast<uint32_t>(*firstIndex);
+}
+
+void GeometryPool::freeVertices(uint32_t firstVertex, uint32_t vertexCount) {
+	if (vertexCount > 0) {
+		m_PendingFrees[m_FrameIndex].vertices.push_back({ firstVertex, vertexCount });
+	}
+}
+
+void GeometryPool::freeIndices(uint32_t firstIndex, uint32_t indexCount) {
+	if (indexCount > 0) {
+		m_PendingFrees[m_FrameIndex].indices.push_back({ firstIndex, indexCount });
+	}
+}
+
+void GeometryPool::beginFrame(int frameIndex) {
+	// ranges are only queued in the slot of the frame that freed them, and the fence of that slot has just been waited
+	// on, so no command buffer that could still read them is in flight
+	m_FrameIndex = frameIndex;
+	release(m_PendingFrees[frameIndex]);
+}
+
+void GeometryPool::release(PendingFrees& frees) {
+	for (const Range& range : frees.vertices) {
+		m_VertexRanges.free(range.first, range.count);
+	}
+
+	for (const Range& range : frees.indices) {
+		m_IndexRanges.free(range.first, range.count);
+	}
+
+	frees.vertices.clear();
+	frees.indices.clear();
+}
+
+void GeometryPool::bind(VkCommandBuffer commandBuffer) const {
+	VkBuffer buffers[] = { m_VertexBuffer->getBuffer() };
+	VkDeviceSize offsets[] = { 0 };
+	vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+
+	vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+}
+
+}
@@ -0,0 +1,75 @@
+#include "Core/IdAllocator.hpp"
+
+#include <stdexcept>
+
+namespace stl {
+
+namespace {
+
+constexpr uint32_t ALIVE_BIT = 1u << 31;
+
+}
+
+IdAllocator::id_t IdAllocator::allocate() {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+	return allocateLocked();
+}
+
+void IdAllocator::allocate(uint32_t count, std::vector<id_t>& ids) {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	ids.reserve(ids.size() + count);
+
+	for (uint32_t i = 0; i < count; i++) {
+		ids.push_back(allocateLocked());
+	}
+}
+
+void IdAllocator::free(id_t id) {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	uint32_t index = getIndex(id);
+
+	if (index >= m_Slots.size() || m_Slots[index] != (getGeneration(id) | ALIVE_BIT)) return;
+
+	m_Slots[index] = (getGeneration(id) + 1) & GENERATION_MASK;
+	m_FreeIndices.push_back(index);
+	m_AliveCount--;
+}
+
+bool IdAllocator::isAlive(id_t id) const {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	uint32_t index = getIndex(id);
+	return index < m_Slots.size() && m_Slots[index] == (getGeneration(id) | ALIVE_BIT);
+}
+
+size_t IdAllocator::getAliveCount() const {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+	return m_AliveCount;
+}
+
+IdAllocator::id_t IdAllocator::allocateLocked() {
+	uint32_t index;
+
+	bool indicesLeft = m_Slots.size() < MAX_INDEX_COUNT;
+
+	if (m_FreeIndices.size() > MIN_FREE_INDICES || (!indicesLeft && !m_FreeIndices.empty())) {
+		index = m_FreeIndices.front();
+		m_FreeIndices.pop_front();
+	} else {
+		if (!indicesLeft) {
+			throw std::runtime_error("Failed to allocate id, all indices are in use!");
+		}
+
+		index = static_cast<uint32_t>(m_Slots.size());
+		m_Slots.push_back(0);
+	}
+
+	m_Slots[index] |= ALIVE_BIT;
+	m_AliveCount++;
+
+	return makeId(index, m_Slots[index] & GENERATION_MASK);
+}
+
+}
@@ -4,7 +4,10 @@
 
 namespace stl {
 
-void KeyboardMovementController::moveInPlaneXZ(float dt, GameObject& gameObject) const {
+void KeyboardMovementController::moveInPlaneXZ(float dt, const GameObject& gameObject) const {
+	TransformComponent& transform = gameObject.getTransform();
+
+	glm::vec3 rotation = transform.getRotation();
 	glm::vec3 rotate{ 0.0f };
 
 	if (Input::isKeyPressed(p_Keys.lookLeft)) rotate.y += 1.0f;
@@ -14,14 +17,15 @@ void KeyboardMovementController::moveInPlaneXZ(float dt, GameObject& gameObject)
 
 	// only normalize (and rotate) if rotation vec is not 0
 	if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
-		gameObject.p_Transform.rotation += p_LookSpeed * dt * glm::normalize(rotate);
+		rotation += p_LookSpeed * dt * glm::normalize(rotate);
 	}
 
 	// limit pitch between ~ +/- 85 degrees
-	gameObject.p_Transform.rotation.x = glm::clamp(gameObject.p_Transform.rotation.x, -1.5f, 1.5f);
-	gameObject.p_Transform.rotation.y = glm::mod(gameObject.p_Transform.rotation.y, glm::two_pi<float>());
+	rotation.x = glm::clamp(rotation.x, -1.5f, 1.5f);
+	rotation.y = glm::mod(rotation.y, glm::two_pi<float>());
+	transform.setRotation(rotation);
 
-	float yaw = gameObject.p_Transform.rotation.y;
+	float yaw = rotation.y;
 	const glm::vec3 forwardDir{ -sin(yaw), 0.0f, -cos(yaw) };
 	const glm::vec3 rightDir{ -forwardDir.z, 0.0f, forwardDir.x };
 	const glm::vec3 upDir = { 0.0f, 1.0f, 0.0f };
@@ -36,7 +40,7 @@ void KeyboardMovementController::moveInPlaneXZ(float dt, GameObject& gameObject)
 
 	// only normalize (and move) if move vec is not 0
 	if (glm::dot(move, move) > std::numeric_limits<float>::epsilon()) {
-		gameObject.p_Transform.translation += p_MoveSpeed * dt * glm::normalize(move);
+		transform.setTranslation(transform.getTranslation() + p_MoveSpeed * dt * glm::normalize(move));
 	}
 }
 
@@ -0,0 +1,248 @@
+#include "renderer/LightClusters.hpp"
+
+#include "Core/Asserts.hpp"
+#include "Core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace stl {
+
+LightClusters::LightClusters(const glm::uvec3& gridSize)
+	: m_GridSize{ gridSize } {
+	SASSERT_MSG(gridSize.x > 0 && gridSize.y > 0 && gridSize.z > 0, "Light cluster grid needs at least one cluster in every direction!");
+}
+
+void LightClusters::setProjection(const glm::mat4& projection) {
+	if (projection == m_Projection) return;
+
+	m_Projection = projection;
+
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	auto unproject = [&](float x, float y, float depth) {
+		glm::vec4 point = inverseProjection * glm::vec4(x, y, depth, 1.0f);
+		return glm::vec3(point) / point.w;
+	};
+
+	// the camera looks down the negative z axis, depths are distances along it
+	m_Near = -unproject(0.0f, 0.0f, 0.0f).z;
+	m_Far = -unproject(0.0f, 0.0f, 1.0f).z;
+
+	SASSERT_MSG(m_Near > 0.0f && m_Far > m_Near, "Light clusters need a perspective projection looking down the negative z axis!");
+
+	float logRatio = std::log(m_Far / m_Near);
+	m_DepthSliceScale = { m_GridSize.z / logRatio, -static_cast<float>(m_GridSize.z) * std::log(m_Near) / logRatio };
+
+	// the edges of the tiles are lines from the near to the far plane, the corners of a cluster lie on them
+	std::vector<glm::vec3> nearPoints;
+	std::vector<glm::vec3> farPoints;
+
+	for (uint32_t y = 0; y <= m_GridSize.y; y++) {
+		for (uint32_t x = 0; x <= m_GridSize.x; x++) {
+			float ndcX = -1.0f + 2.0f * x / m_GridSize.x;
+			float ndcY = -1.0f + 2.0f * y / m_GridSize.y;
+
+			nearPoints.push_back(unproject(ndcX, ndcY, 0.0f));
+			farPoints.push_back(unproject(ndcX, ndcY, 1.0f));
+		}
+	}
+
+	auto pointAtDepth = [&](uint32_t x, uint32_t y, float depth) {
+		size_t edge = x + (m_GridSize.x + 1) * y;
+
+		const glm::vec3& a = nearPoints[edge];
+		const glm::vec3& b = farPoints[edge];
+
+		return a + (b - a) * ((-depth - a.z) / (b.z - a.z));
+	};
+
+	// planes through three points of two neighbouring edge lines, facing the reference point
+	auto edgePlane = [&](size_t edge, size_t neighbour, const glm::vec3& reference) {
+		glm::vec3 normal = glm::normalize(glm::cross(farPoints[edge] - nearPoints[edge], farPoints[neighbour] - nearPoints[edge]));
+		glm::vec4 plane{ normal, -glm::dot(normal, nearPoints[edge]) };
+
+		return glm::dot(glm::vec3(plane), reference) + plane.w < 0.0f ? -plane : plane;
+	};
+
+	m_ColumnPlanes.clear();
+	m_RowPlanes.clear();
+
+	for (uint32_t x = 0; x <= m_GridSize.x; x++) {
+		float ndcX = -1.0f + (2.0f * x + 1.0f) / m_GridSize.x;
+		m_ColumnPlanes.push_back(edgePlane(x, x + (m_GridSize.x + 1) * m_GridSize.y, unproject(ndcX, 0.0f, 1.0f)));
+	}
+
+	for (uint32_t y = 0; y <= m_GridSize.y; y++) {
+		float ndcY = -1.0f + (2.0f * y + 1.0f) / m_GridSize.y;
+		size_t edge = (m_GridSize.x + 1) * y;
+		m_RowPlanes.push_back(edgePlane(edge, edge + m_GridSize.x, unproject(0.0f, ndcY, 1.0f)));
+	}
+
+	m_ClusterBounds.clear();
+
+	for (uint32_t slice = 0; slice < m_GridSize.z; slice++) {
+		float sliceNear = m_Near * std::pow(m_Far / m_Near, static_cast<float>(slice) / m_GridSize.z);
+		float sliceFar = m_Near * std::pow(m_Far / m_Near, static_cast<float>(slice + 1) / m_GridSize.z);
+
+		for (uint32_t y = 0; y < m_GridSize.y; y++) {
+			for (uint32_t x = 0; x < m_GridSize.x; x++) {
+				Aabb bounds{ glm::vec3{ std::numeric_limits<float>::max() }, glm::vec3{ std::numeric_limits<float>::lowest() } };
+
+				for (uint32_t corner = 0; corner < 8; corner++) {
+					float depth = corner & 4 ? sliceFar : sliceNear;
+					glm::vec3 point = pointAtDepth(x + (corner & 1), y + ((corner >> 1) & 1), depth);
+
+					bounds.min = glm::min(bounds.min, point);
+					bounds.max = glm::max(bounds.max, point);
+				}
+
+				m_ClusterBounds.push(bounds);
+			}
+		}
+	}
+
+	m_ClusterBounds.pad();
+}
+
+void LightClusters::build(const std::vector<glm::vec4>& viewSpheres) {
+	build(viewSpheres, ClusterKernel::getBestPath(), true);
+}
+
+void LightClusters::build(const std::vector<glm::vec4>& viewSpheres, ClusterKernel::Path path, bool multithreaded) {
+	SASSERT_MSG(m_ClusterBounds.size() > getClusterCount(), "Light clusters need a projection before lights can be assigned!");
+
+	ThreadPool& pool = ThreadPool::get();
+
+	uint32_t lightCount = static_cast<uint32_t>(viewSpheres.size());
+	uint32_t clusterCount = getClusterCount();
+
+	size_t chunkCount = multithreaded ? std::min<size_t>(lightCount / MIN_LIGHTS_PER_CHUNK, 2 * (pool.getThreadCount() + 1)) : 1;
+	chunkCount = std::max<size_t>(chunkCount, 1);
+
+	if (m_Chunks.size() < chunkCount) {
+		m_Chunks.resize(chunkCount);
+	}
+
+	auto chunkBegin = [&](size_t chunk) { return static_cast<uint32_t>(lightCount * chunk / chunkCount); };
+
+	// every chunk bins its lights into its own list, lights stay in ascending order within a list
+	pool.parallelFor(chunkCount, [&](size_t chunk) {
+		binLights(viewSpheres, chunkBegin(chunk), chunkBegin(chunk + 1), m_Chunks[chunk], path);
+	});
+
+	// the clusters are laid out one after another, within a cluster the chunks follow in order,
+	// so the counts of the chunks become their write positions
+	m_Clusters.resize(clusterCount);
+
+	uint32_t offset = 0;
+
+	for (uint32_t cluster = 0; cluster < clusterCount; cluster++) {
+		m_Clusters[cluster].offset = offset;
+
+		for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+			uint32_t count = m_Chunks[chunk].clusterCounts[cluster];
+			m_Chunks[chunk].clusterCounts[cluster] = offset;
+			offset += count;
+		}
+
+		m_Clusters[cluster].count = offset - m_Clusters[cluster].offset;
+	}
+
+	m_LightIndices.resize(offset);
+
+	pool.parallelFor(chunkCount, [&](size_t chunk) {
+		std::vector<uint32_t>& positions = m_Chunks[chunk].clusterCounts;
+
+		for (const glm::uvec2& assignment : m_Chunks[chunk].assignments) {
+			m_LightIndices[positions[assignment.x]++] = assignment.y;
+		}
+	});
+}
+
+void LightClusters::binLights(const std::vector<glm::vec4>& viewSpheres, uint32_t begin, uint32_t end, Chunk& chunk, ClusterKernel::Path path) const {
+	chunk.assignments.clear();
+	chunk.clusterCounts.assign(getClusterCount(), 0);
+	chunk.hits.resize(m_GridSize.x);
+
+	for (uint32_t light = begin; light < end; light++) {
+		const glm::vec4& sphere = viewSpheres[light];
+
+		glm::vec3 center{ sphere };
+		float radius = sphere.w;
+
+		uint32_t firstSlice, lastSlice;
+		uint32_t firstX, lastX;
+		uint32_t firstY, lastY;
+
+		if (!getSliceRange(-center.z - radius, -center.z + radius, firstSlice, lastSlice)) continue;
+		if (!getTileRange(m_ColumnPlanes, center, radius, firstX, lastX)) continue;
+		if (!getTileRange(m_RowPlanes, center, radius, firstY, lastY)) continue;
+
+		for (uint32_t slice = firstSlice; slice <= lastSlice; slice++) {
+			for (uint32_t y = firstY; y <= lastY; y++) {
+				uint32_t row = getClusterIndex(0, y, slice);
+				uint32_t hitCount = ClusterKernel::intersectSphere(sphere, m_ClusterBounds, row + firstX, row + lastX + 1, chunk.hits.data(), path);
+
+				for (uint32_t i = 0; i < hitCount; i++) {
+					chunk.assignments.push_back({ chunk.hits[i], light });
+					chunk.clusterCounts[chunk.hits[i]]++;
+				}
+			}
+		}
+	}
+}
+
+bool LightClusters::getSliceRange(float minDepth, float maxDepth, uint32_t& first, uint32_t& last) const {
+	if (maxDepth < m_Near || minDepth > m_Far) return false;
+
+	auto slice = [&](float depth) {
+		float value = std::floor(std::log(depth) * m_DepthSliceScale.x + m_DepthSliceScale.y);
+		return static_cast<uint32_t>(std::clamp(value, 0.0f, static_cast<float>(m_GridSize.z - 1)));
+	};
+
+	first = slice(std::max(minDepth, m_Near));
+	last = slice(std::min(maxDepth, m_Far));
+
+	return true;
+}
+
+bool LightClusters::getTileRange(const std::vector<glm::vec4>& planes, const glm::vec3& center, float radius, uint32_t& first, uint32_t& last) {
+	// the distances to the planes decrease with their index, a tile lies between the planes of its index and the next
+	auto distance = [&](size_t plane) { return glm::dot(glm::vec3(planes[plane]), center) + planes[plane].w; };
+
+	uint32_t tileCount = static_cast<uint32_t>(planes.size() - 1);
+
+	// first tile whose upper plane is within the radius
+	uint32_t low = 0;
+	uint32_t high = tileCount;
+
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+
+		if (distance(middle + 1) > radius) low = middle + 1;
+		else high = middle;
+	}
+
+	first = low;
+
+	if (first == tileCount || distance(first) < -radius) return false;
+
+	// last tile whose lower plane is within the radius
+	low = first;
+	high = tileCount - 1;
+
+	while (low < high) {
+		uint32_t middle = (low + high + 1) / 2;
+
+		if (distance(middle) < -radius) high = middle - 1;
+		else low = middle;
+	}
+
+	last = low;
+
+	return true;
+}
+
+}
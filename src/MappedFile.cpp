@@ -0,0 +1,97 @@
+#include "Core/MappedFile.hpp"
+
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stl {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filepath) {
+	HANDLE file = CreateFileW(std::filesystem::absolute(filepath).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		return;
+	}
+
+	m_Data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (m_Data == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return;
+	}
+
+	m_File = file;
+	m_Mapping = mapping;
+	m_Size = static_cast<size_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+	if (m_Data) {
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_Mapping);
+		CloseHandle(m_File);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filepath) {
+	int fd = open(std::filesystem::absolute(filepath).c_str(), O_RDONLY);
+
+	if (fd < 0) {
+		return;
+	}
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		close(fd);
+		return;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps its own reference to the file
+
+	if (data == MAP_FAILED) {
+		return;
+	}
+
+	m_Data = data;
+	m_Size = static_cast<size_t>(info.st_size);
+}
+
+MappedFile::~MappedFile() {
+	if (m_Data) {
+		munmap(m_Data, m_Size);
+	}
+}
+
+#endif
+
+}
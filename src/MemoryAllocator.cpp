@@ -0,0 +1,256 @@
+#include "renderer/wrapper/MemoryAllocator.hpp"
+
+#include "Core/Logger.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace stl {
+
+MemoryAllocator::MemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice)
+	: MemoryAllocator{ std::make_unique<VulkanMemoryBackend>(device, physicalDevice) } {
+}
+
+MemoryAllocator::MemoryAllocator(std::unique_ptr<MemoryBackend> backend)
+	: m_Backend{ std::move(backend) } {
+	m_MemoryProperties = m_Backend->getMemoryProperties();
+	m_NonCoherentAtomSize = std::max<VkDeviceSize>(m_Backend->getNonCoherentAtomSize(), 1);
+
+	// one pool for linear and one for optimal resources per memory type
+	m_Pools.resize(m_MemoryProperties.memoryTypeCount * 2);
+
+	for (uint32_t i = 0; i < m_Pools.size(); i++) {
+		m_Pools[i].memoryTypeIndex = i / 2;
+	}
+}
+
+MemoryAllocator::~MemoryAllocator() {
+	for (Pool& pool : m_Pools) {
+		for (auto& block : pool.blocks) {
+			if (!block) continue;
+
+			if (block->allocationCount > 0) {
+				SWARN("Destroying memory block with ", block->allocationCount, " live allocations");
+			}
+
+			freeDeviceMemory(block->memory, block->mapped);
+		}
+	}
+
+	if (m_DedicatedAllocationCount > 0) {
+		SWARN(m_DedicatedAllocationCount, " dedicated allocations were not freed");
+	}
+}
+
+Allocation MemoryAllocator::allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear) {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, properties);
+	const VkMemoryType& memoryType = m_MemoryProperties.memoryTypes[memoryTypeIndex];
+
+	VkDeviceSize size = requirements.size;
+	VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+
+	// keep mapped allocations on atom boundaries so that flushing one never touches a neighbor
+	if (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+		alignment = std::max(alignment, m_NonCoherentAtomSize);
+		size = (size + m_NonCoherentAtomSize - 1) / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+	}
+
+	VkDeviceSize heapSize = m_MemoryProperties.memoryHeaps[memoryType.heapIndex].size;
+	VkDeviceSize blockSize = std::min(DEFAULT_BLOCK_SIZE, heapSize / 8);
+
+	Allocation allocation{};
+
+	// large resources get their own memory instead of wasting most of a block
+	if (size > blockSize / 2) {
+		allocation.memory = allocateDeviceMemory(size, memoryTypeIndex, &allocation.mapped);
+		allocation.size = size;
+		allocation.dedicated = true;
+
+		m_DedicatedAllocationCount++;
+		m_DedicatedBytes += size;
+
+		return allocation;
+	}
+
+	uint32_t poolIndex = memoryTypeIndex * 2 + (linear ? 0 : 1);
+	Pool& pool = m_Pools[poolIndex];
+
+	for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+		Block* block = pool.blocks[i].get();
+
+		if (!block) continue;
+
+		if (auto offset = block->suballocator.allocate(size, alignment)) {
+			block->allocationCount++;
+
+			allocation.memory = block->memory;
+			allocation.offset = *offset;
+			allocation.size = size;
+			allocation.mapped = block->mapped ? static_cast<char*>(block->mapped) + *offset : nullptr;
+			allocation.poolIndex = poolIndex;
+			allocation.blockIndex = i;
+
+			return allocation;
+		}
+	}
+
+	auto block = std::make_unique<Block>(Block{ VK_NULL_HANDLE, nullptr, BlockSuballocator{ blockSize }, 1 });
+	block->memory = allocateDeviceMemory(blockSize, memoryTypeIndex, &block->mapped);
+
+	VkDeviceSize offset = *block->suballocator.allocate(size, alignment);
+
+	// reuse the slot of a released block so that block indices stay stable
+	auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+
+	if (slot == pool.blocks.end()) {
+		slot = pool.blocks.insert(pool.blocks.end(), nullptr);
+	}
+
+	allocation.memory = block->memory;
+	allocation.offset = offset;
+	allocation.size = size;
+	allocation.mapped = block->mapped ? static_cast<char*>(block->mapped) + offset : nullptr;
+	allocation.poolIndex = poolIndex;
+	allocation.blockIndex = static_cast<uint32_t>(slot - pool.blocks.begin());
+
+	*slot = std::move(block);
+
+	return allocation;
+}
+
+void MemoryAllocator::free(Allocation& allocation) {
+	if (allocation.memory == VK_NULL_HANDLE) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	if (allocation.dedicated) {
+		freeDeviceMemory(allocation.memory, allocation.mapped);
+
+		m_DedicatedAllocationCount--;
+		m_DedicatedBytes -= allocation.size;
+	} else {
+		Pool& pool = m_Pools[allocation.poolIndex];
+		auto& block = pool.blocks[allocation.blockIndex];
+
+		block->suballocator.free(allocation.offset, allocation.size);
+		block->allocationCount--;
+
+		// keep one empty block around per pool to avoid churn
+		if (block->allocationCount == 0) {
+			auto otherBlocks = std::count_if(pool.blocks.begin(), pool.blocks.end(), [](const auto& other) { return other != nullptr; });
+
+			if (otherBlocks > 1) {
+				freeDeviceMemory(block->memory, block->mapped);
+				block.reset();
+			}
+		}
+	}
+
+	allocation = Allocation{};
+}
+
+VkResult MemoryAllocator::flush(const Allocation& allocation, VkDeviceSize size, VkDeviceSize offset) const {
+	return m_Backend->flushMemory(mappedRange(allocation, size, offset));
+}
+
+VkResult MemoryAllocator::invalidate(const Allocation& allocation, VkDeviceSize size, VkDeviceSize offset) const {
+	return m_Backend->invalidateMemory(mappedRange(allocation, size, offset));
+}
+
+void MemoryAllocator::trim() {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	for (Pool& pool : m_Pools) {
+		for (auto& block : pool.blocks) {
+			if (block && block->allocationCount == 0) {
+				freeDeviceMemory(block->memory, block->mapped);
+				block.reset();
+			}
+		}
+	}
+}
+
+MemoryAllocator::Statistics MemoryAllocator::getStatistics() const {
+	std::lock_guard<std::mutex> lock{ m_Mutex };
+
+	Statistics stats{};
+	stats.dedicatedAllocationCount = m_DedicatedAllocationCount;
+	stats.allocationCount = m_DedicatedAllocationCount;
+	stats.reservedBytes = m_DedicatedBytes;
+	stats.usedBytes = m_DedicatedBytes;
+
+	for (const Pool& pool : m_Pools) {
+		for (const auto& block : pool.blocks) {
+			if (!block) continue;
+
+			stats.blockCount++;
+			stats.allocationCount += block->allocationCount;
+			stats.reservedBytes += block->suballocator.getSize();
+			stats.usedBytes += block->suballocator.getUsedSize();
+			stats.largestFreeRange = std::max(stats.largestFreeRange, block->suballocator.getLargestFreeRange());
+			stats.freeRangeCount += block->suballocator.getFreeRangeCount();
+		}
+	}
+
+	return stats;
+}
+
+uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+	for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++) {
+		if ((typeFilter & (1 << i)) && (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+			return i;
+		}
+	}
+
+	throw std::runtime_error("Failed to find suitable memory type!");
+}
+
+VkDeviceMemory MemoryAllocator::allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, void** mapped) {
+	VkDeviceMemory memory;
+
+	if (m_Backend->allocateMemory(size, memoryTypeIndex, &memory) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to allocate device memory!");
+	}
+
+	*mapped = nullptr;
+
+	// host visible memory stays mapped for its whole lifetime, a memory object can only be mapped once
+	if (m_MemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+		if (m_Backend->mapMemory(memory, mapped) != VK_SUCCESS) {
+			m_Backend->freeMemory(memory);
+			throw std::runtime_error("Failed to map device memory!");
+		}
+	}
+
+	return memory;
+}
+
+void MemoryAllocator::freeDeviceMemory(VkDeviceMemory memory, void* mapped) {
+	if (mapped) {
+		m_Backend->unmapMemory(memory);
+	}
+
+	m_Backend->freeMemory(memory);
+}
+
+VkMappedMemoryRange MemoryAllocator::mappedRange(const Allocation& allocation, VkDeviceSize size, VkDeviceSize offset) const {
+	VkDeviceSize begin = allocation.offset + offset;
+	VkDeviceSize end = size == VK_WHOLE_SIZE ? allocation.offset + allocation.size : begin + size;
+
+	begin = begin / m_NonCoherentAtomSize * m_NonCoherentAtomSize;
+	end = std::min((end + m_NonCoherentAtomSize - 1) / m_NonCoherentAtomSize * m_NonCoherentAtomSize, allocation.offset + allocation.size);
+
+	VkMappedMemoryRange range = {};
+	range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	range.memory = allocation.memory;
+	range.offset = begin;
+	range.size = end - begin;
+
+	return range;
+}
+
+}
@@ -0,0 +1,167 @@
+#include "renderer/MeshCache.hpp"
+
+#include "Core/Logger.hpp"
+#include "Core/MappedFile.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace stl {
+
+namespace {
+
+struct Header {
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexSize;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	float weldEpsilon;
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	uint64_t sourceHash;
+};
+
+constexpr char MAGIC[4] = { 'S', 'L', 'M', 'C' };
+
+struct SourceInfo {
+	uint64_t size;
+	int64_t time;
+};
+
+bool querySource(const std::string& filepath, SourceInfo& info) {
+	std::error_code ec;
+
+	uintmax_t size = std::filesystem::file_size(filepath, ec);
+	if (ec) return false;
+
+	auto time = std::filesystem::last_write_time(filepath, ec);
+	if (ec) return false;
+
+	info.size = static_cast<uint64_t>(size);
+	info.time = static_cast<int64_t>(time.time_since_epoch().count());
+
+	return true;
+}
+
+// 64-bit FNV-1a over the raw source bytes
+uint64_t hashSource(const std::string& filepath) {
+	MappedFile file{ filepath };
+
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(file.getData());
+
+	for (size_t i = 0; i < file.getSize(); i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+}
+
+std::string MeshCache::getCachePath(const std::string& filepath) {
+	return filepath + EXTENSION;
+}
+
+bool MeshCache::load(const std::string& filepath, Model::Data& data) {
+	MappedFile cache{ getCachePath(filepath) };
+
+	if (!cache.isOpen() || cache.getSize() < sizeof(Header)) {
+		return false;
+	}
+
+	Header header;
+	memcpy(&header, cache.getData(), sizeof(Header));
+
+	if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION || header.vertexSize != sizeof(Model::Vertex) || header.weldEpsilon != data.weldEpsilon) {
+		return false;
+	}
+
+	size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(Model::Vertex);
+	size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+
+	if (cache.getSize() != sizeof(Header) + vertexBytes + indexBytes) {
+		return false;
+	}
+
+	// a missing source is fine, baked caches may be shipped on their own
+	SourceInfo source;
+
+	if (querySource(filepath, source)) {
+		if (source.size != header.sourceSize) {
+			return false;
+		}
+
+		// the timestamp changes on checkout even if the contents do not, so fall back to the hash
+		if (source.time != header.sourceTime && hashSource(filepath) != header.sourceHash) {
+			return false;
+		}
+	}
+
+	const char* payload = cache.getData() + sizeof(Header);
+
+	data.vertices.resize(header.vertexCount);
+	data.indices.resize(header.indexCount);
+
+	memcpy(data.vertices.data(), payload, vertexBytes);
+	memcpy(data.indices.data(), payload + vertexBytes, indexBytes);
+
+	return true;
+}
+
+bool MeshCache::store(const std::string& filepath, const Model::Data& data) {
+	SourceInfo source;
+
+	if (!querySource(filepath, source)) {
+		return false;
+	}
+
+	Header header{};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.vertexSize = sizeof(Model::Vertex);
+	header.vertexCount = static_cast<uint32_t>(data.vertices.size());
+	header.indexCount = static_cast<uint32_t>(data.indices.size());
+	header.weldEpsilon = data.weldEpsilon;
+	header.sourceSize = source.size;
+	header.sourceTime = source.time;
+	header.sourceHash = hashSource(filepath);
+
+	std::string cachePath = getCachePath(filepath);
+	std::string tempPath = cachePath + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+		if (!file.is_open()) {
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(reinterpret_cast<const char*>(data.vertices.data()), data.vertices.size() * sizeof(Model::Vertex));
+		file.write(reinterpret_cast<const char*>(data.indices.data()), data.indices.size() * sizeof(uint32_t));
+
+		if (!file.good()) {
+			return false;
+		}
+	}
+
+	// rename so that concurrent readers never see a partially written cache
+	std::error_code ec;
+	std::filesystem::rename(tempPath, cachePath, ec);
+
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+
+	return true;
+}
+
+}
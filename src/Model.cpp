@@ -1,118 +1,129 @@
 #include "renderer/Model.hpp"
 
 #include "Core/Asserts.hpp"
-#include "Core/Common.hpp"
+#include "Core/ThreadPool.hpp"
+#include "renderer/GeometryPool.hpp"
+#include "renderer/MeshCache.hpp"
+#include "renderer/VertexWelder.hpp"
 
 #include <tiny_obj_loader.h>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <filesystem>
-#include <unordered_map>
 
-namespace std {
+namespace stl {
+
+namespace {
+
+constexpr size_t MIN_CORNERS_PER_CHUNK = 1 << 16;
+
+Model::Vertex assembleVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& index) {
+	Model::Vertex vertex{};
+
+	if (index.vertex_index >= 0) {
+		vertex.position = {
+			attrib.vertices[3 * index.vertex_index + 0],
+			attrib.vertices[3 * index.vertex_index + 1],
+			attrib.vertices[3 * index.vertex_index + 2]
+		};
 
-template <>
-struct hash<stl::Model::Vertex> {
-	size_t operator()(const stl::Model::Vertex& vertex) const {
-		size_t seed = 0;
-		stl::Common::hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
-		return seed;
+		vertex.color = {
+			attrib.colors[3 * index.vertex_index + 0],
+			attrib.colors[3 * index.vertex_index + 1],
+			attrib.colors[3 * index.vertex_index + 2]
+		};
 	}
-};
 
-}
+	if (index.normal_index >= 0) {
+		vertex.normal = {
+			attrib.normals[3 * index.normal_index + 0],
+			attrib.normals[3 * index.normal_index + 1],
+			attrib.normals[3 * index.normal_index + 2]
+		};
+	}
 
-namespace stl {
+	if (index.texcoord_index >= 0) {
+		vertex.uv = {
+			attrib.texcoords[2 * index.texcoord_index + 0],
+			attrib.texcoords[2 * index.texcoord_index + 1]
+		};
+	}
 
-Model::Model(Device& device, const Model::Data& data)
-	: m_Device{ device } {
-	createVertexBuffers(data.vertices);
-	createIndexBuffers(data.indices);
+	return vertex;
 }
 
-Model::~Model() {
 }
 
-std::unique_ptr<Model> Model::createModelFromFile(Device& device, const std::string& filepath) {
-	Data data{};
-	data.loadModel(filepath);
-	return std::make_unique<Model>(device, data);
+Model::Model(GeometryPool& pool, const Model::Data& data)
+	: Model{ pool, data, pool.getTransferContext() } {
+	// standalone models are used right away, so the batch holding their copies is submitted and waited on
+	TransferContext& transfer = m_Pool.getTransferContext();
+	transfer.wait(transfer.getRecordingTicket());
 }
 
-void Model::bind(VkCommandBuffer commandBuffer) {
-	VkBuffer buffers[] = { m_VertexBuffer->getBuffer()};
-	VkDeviceSize offsets[] = { 0 };
-	vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+Model::Model(GeometryPool& pool, const Model::Data& data, TransferContext& transfer)
+	: m_Pool{ pool }, m_Bounds{ data.bounds } {
+	createVertexBuffers(data.vertices, transfer);
 
-	if (m_HasIndexBuffer) {
-		vkCmdBindIndexBuffer(commandBuffer, m_IndexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+	try {
+		createIndexBuffers(data.indices, transfer);
+	} catch (...) {
+		m_Pool.freeVertices(m_FirstVertex, m_VertexCount);
+		throw;
 	}
 }
 
-void Model::draw(VkCommandBuffer commandBuffer) const {
+Model::~Model() {
+	m_Pool.freeVertices(m_FirstVertex, m_VertexCount);
+	m_Pool.freeIndices(m_FirstIndex, m_IndexCount);
+}
+
+std::unique_ptr<Model> Model::createModelFromFile(GeometryPool& pool, const std::string& filepath) {
+	Data data{};
+	data.loadModel(filepath);
+	return std::make_unique<Model>(pool, data);
+}
+
+void Model::draw(VkCommandBuffer commandBuffer, uint32_t firstInstance, uint32_t instanceCount) const {
 	if (m_HasIndexBuffer) {
-		vkCmdDrawIndexed(commandBuffer, m_IndexCount, 1, 0, 0, 0);
+		vkCmdDrawIndexed(commandBuffer, m_IndexCount, instanceCount, m_FirstIndex, static_cast<int32_t>(m_FirstVertex), firstInstance);
 	} else {
-		vkCmdDraw(commandBuffer, m_VertexCount, 1, 0, 0);
+		vkCmdDraw(commandBuffer, m_VertexCount, instanceCount, m_FirstVertex, firstInstance);
 	}
 }
 
-void Model::createVertexBuffers(const std::vector<Vertex>& vertices) {
-	m_VertexCount = static_cast<uint32_t>(vertices.size());
-
-	SASSERT_MSG(m_VertexCount >= 3, "Vertex count must be at least 3");
+VkDrawIndexedIndirectCommand Model::getDrawCommand(uint32_t firstInstance, uint32_t instanceCount) const {
+	SASSERT_MSG(m_HasIndexBuffer, "Indirect draw commands require an index buffer");
 
-	uint32_t vertexSize = sizeof(vertices[0]);
-	VkDeviceSize bufferSize = vertexSize * m_VertexCount;
+	VkDrawIndexedIndirectCommand command = {};
+	command.indexCount = m_IndexCount;
+	command.instanceCount = instanceCount;
+	command.firstIndex = m_FirstIndex;
+	command.vertexOffset = static_cast<int32_t>(m_FirstVertex);
+	command.firstInstance = firstInstance;
 
-	Buffer stagingBuffer{ m_Device,
-		vertexSize,
-		m_VertexCount,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
+	return command;
+}
 
-	stagingBuffer.map();
-	stagingBuffer.writeToBuffer((void*)vertices.data());
+void Model::createVertexBuffers(const std::vector<Vertex>& vertices, TransferContext& transfer) {
+	m_VertexCount = static_cast<uint32_t>(vertices.size());
 
-	m_VertexBuffer = std::make_unique<Buffer>(m_Device,
-		vertexSize,
-		m_VertexCount,
-		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	SASSERT_MSG(m_VertexCount >= 3, "Vertex count must be at least 3");
 
-	m_Device.copyBuffer(stagingBuffer.getBuffer(), m_VertexBuffer->getBuffer(), bufferSize);
+	m_FirstVertex = m_Pool.allocateVertices(vertices, transfer);
 }
 
-void Model::createIndexBuffers(const std::vector<uint32_t>& indices) {
-	m_IndexCount = static_cast<uint32_t>(indices.size());
-
-	m_HasIndexBuffer = m_IndexCount > 0;
+void Model::createIndexBuffers(const std::vector<uint32_t>& indices, TransferContext& transfer) {
+	m_HasIndexBuffer = !indices.empty();
 
 	if (!m_HasIndexBuffer) {
 		return;
 	}
 
-	uint32_t indexSize = sizeof(indices[0]);
-	VkDeviceSize bufferSize = indexSize * m_IndexCount;
-
-	Buffer stagingBuffer{ m_Device,
-		indexSize,
-		m_IndexCount,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
-
-	stagingBuffer.map();
-	stagingBuffer.writeToBuffer((void*)indices.data());
-
-	m_IndexBuffer = std::make_unique<Buffer>(m_Device,
-		indexSize,
-		m_IndexCount,
-		VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-	m_Device.copyBuffer(stagingBuffer.getBuffer(), m_IndexBuffer->getBuffer(), bufferSize);
+	m_FirstIndex = m_Pool.allocateIndices(indices, transfer);
+	m_IndexCount = static_cast<uint32_t>(indices.size());
 }
 
 std::vector<VkVertexInputBindingDescription> Model::Vertex::getBindingDescriptions() {
@@ -150,6 +161,46 @@ std::vector<VkVertexInputAttributeDescription> Model::Vertex::getAttributeDescri
 }
 
 void Model::Data::loadModel(const std::string& filepath) {
+	if (!MeshCache::load(filepath, *this)) {
+		loadObj(filepath);
+
+		if (!MeshCache::store(filepath, *this)) {
+			SWARN("Failed to write mesh cache for ", filepath);
+		}
+	}
+
+	computeBounds();
+}
+
+void Model::Data::computeBounds() {
+	bounds = Bounds{};
+
+	if (vertices.empty()) {
+		return;
+	}
+
+	bounds.min = vertices[0].position;
+	bounds.max = vertices[0].position;
+
+	for (const Vertex& vertex : vertices) {
+		bounds.min = glm::min(bounds.min, vertex.position);
+		bounds.max = glm::max(bounds.max, vertex.position);
+	}
+
+	// centered on the box, tighter than half its diagonal for most meshes
+	bounds.center = (bounds.min + bounds.max) * 0.5f;
+
+	float radiusSquared = 0.0f;
+
+	for (const Vertex& vertex : vertices) {
+		glm::vec3 offset = vertex.position - bounds.center;
+		radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+	}
+
+	bounds.radius = std::sqrt(radiusSquared);
+}
+
+void Model::Data::loadObj(const std::string& filepath) {
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
 	std::vector<tinyobj::material_t> materials;
@@ -163,49 +214,76 @@ void Model::Data::loadModel(const std::string& filepath) {
 	vertices.clear();
 	indices.clear();
 
-	std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+	// corners of all shapes are treated as one contiguous range
+	std::vector<size_t> shapeOffsets(shapes.size() + 1, 0);
 
-	for (const auto& shape : shapes) {
-		for (const auto& index : shape.mesh.indices) {
-			Vertex vertex{};
+	for (size_t i = 0; i < shapes.size(); i++) {
+		shapeOffsets[i + 1] = shapeOffsets[i] + shapes[i].mesh.indices.size();
+	}
 
-			if (index.vertex_index >= 0) {
-				vertex.position = {
-					attrib.vertices[3 * index.vertex_index + 0],
-					attrib.vertices[3 * index.vertex_index + 1],
-					attrib.vertices[3 * index.vertex_index + 2]
-				};
+	size_t indexCount = shapeOffsets.back();
+	indices.resize(indexCount);
 
-				vertex.color = {
-					attrib.colors[3 * index.vertex_index + 0],
-					attrib.colors[3 * index.vertex_index + 1],
-					attrib.colors[3 * index.vertex_index + 2]
-				};
-			}
+	auto weldRange = [&](size_t begin, size_t end, VertexWelder& welder) {
+		size_t shape = std::upper_bound(shapeOffsets.begin(), shapeOffsets.end(), begin) - shapeOffsets.begin() - 1;
 
-			if (index.normal_index >= 0) {
-				vertex.normal = {
-					attrib.normals[3 * index.normal_index + 0],
-					attrib.normals[3 * index.normal_index + 1],
-					attrib.normals[3 * index.normal_index + 2]
-				};
+		for (size_t i = begin; i < end; i++) {
+			while (i >= shapeOffsets[shape + 1]) {
+				shape++;
 			}
 
-			if (index.texcoord_index >= 0) {
-				vertex.uv = {
-					attrib.texcoords[2 * index.texcoord_index + 0],
-					attrib.texcoords[2 * index.texcoord_index + 1]
-				};
-			}
+			const tinyobj::index_t& index = shapes[shape].mesh.indices[i - shapeOffsets[shape]];
+			indices[i] = welder.weld(assembleVertex(attrib, index));
+		}
+	};
 
-			if (uniqueVertices.count(vertex) == 0) {
-				uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-				vertices.push_back(vertex);
-			}
+	ThreadPool& pool = ThreadPool::get();
+	size_t chunkCount = std::min(indexCount / MIN_CORNERS_PER_CHUNK, 2 * (pool.getThreadCount() + 1));
+
+	// welding within epsilon is not transitive and keeps the first match it finds, so welding chunks on their own and
+	// then their vertices again could merge different vertices than the serial path, only exact welding is split up
+	if (chunkCount <= 1 || weldEpsilon > 0.0f) {
+		VertexWelder welder{ vertices, indexCount, weldEpsilon };
+		weldRange(0, indexCount, welder);
+		return;
+	}
+
+	// weld each chunk on its own, indices are local to the chunk for now
+	std::vector<std::vector<Vertex>> chunkVertices(chunkCount);
+
+	auto chunkBegin = [&](size_t chunk) { return indexCount * chunk / chunkCount; };
+
+	pool.parallelFor(chunkCount, [&](size_t chunk) {
+		size_t begin = chunkBegin(chunk);
+		size_t end = chunkBegin(chunk + 1);
 
-			indices.push_back(uniqueVertices[vertex]);
+		VertexWelder welder{ chunkVertices[chunk], end - begin, weldEpsilon };
+		weldRange(begin, end, welder);
+	});
+
+	// merging the chunks in order adds every vertex at its first occurrence, just like the serial path
+	size_t uniqueCount = 0;
+
+	for (const auto& chunk : chunkVertices) {
+		uniqueCount += chunk.size();
+	}
+
+	std::vector<std::vector<uint32_t>> remap(chunkCount);
+	VertexWelder welder{ vertices, uniqueCount, weldEpsilon };
+
+	for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+		remap[chunk].reserve(chunkVertices[chunk].size());
+
+		for (const Vertex& vertex : chunkVertices[chunk]) {
+			remap[chunk].push_back(welder.weld(vertex));
 		}
 	}
+
+	pool.parallelFor(chunkCount, [&](size_t chunk) {
+		for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+			indices[i] = remap[chunk][indices[i]];
+		}
+	});
 }
 
 }
\ No newline at end of file
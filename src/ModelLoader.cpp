@@ -0,0 +1,102 @@
+#include "renderer/ModelLoader.hpp"
+
+#include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
+
+#include <chrono>
+
+namespace stl {
+
+ModelLoader::ModelLoader(Device& device, GeometryPool& pool)
+	: m_Device{ device }, m_Pool{ pool }, m_Transfer{ pool.getTransferContext() } {
+}
+
+ModelLoader::~ModelLoader() {
+	// parse tasks only hold a copy of the filepath, so they can safely finish on their own,
+	// but buffers must not be destroyed while copies into them are in flight
+	m_Transfer.waitIdle();
+
+	for (auto& request : m_Pending) {
+		if (request->data.valid()) {
+			request->data.wait();
+		}
+	}
+}
+
+ModelLoader::Handle ModelLoader::load(const std::string& filepath, Callback onReady) {
+	auto request = std::make_shared<Request>();
+	request->filepath = filepath;
+	request->onReady = std::move(onReady);
+
+	request->data = ThreadPool::get().submit([filepath]() {
+		Model::Data data{};
+		data.loadModel(filepath);
+		return data;
+	});
+
+	m_Pending.push_back(request);
+
+	return Handle{ request };
+}
+
+void ModelLoader::update() {
+	bool recorded = false;
+
+	for (auto& request : m_Pending) {
+		if (request->uploading || request->failed) continue;
+
+		if (request->data.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+			recorded |= startUpload(*request);
+		}
+	}
+
+	if (recorded) {
+		m_Transfer.submit();
+	}
+
+	for (size_t i = 0; i < m_Pending.size();) {
+		Request& request = *m_Pending[i];
+
+		if (request.uploading && m_Transfer.isComplete(request.uploadTicket)) {
+			request.model = std::move(request.uploading);
+
+			if (request.onReady) {
+				request.onReady(request.model);
+			}
+		} else if (!request.failed) {
+			i++;
+			continue;
+		}
+
+		m_Pending[i] = std::move(m_Pending.back());
+		m_Pending.pop_back();
+	}
+}
+
+void ModelLoader::waitIdle() {
+	for (auto& request : m_Pending) {
+		if (request->data.valid()) {
+			request->data.wait();
+		}
+	}
+
+	update();
+	m_Transfer.waitIdle();
+	update();
+}
+
+bool ModelLoader::startUpload(Request& request) {
+	try {
+		Model::Data data = request.data.get();
+		request.uploading = std::make_shared<Model>(m_Pool, data, m_Transfer);
+		request.uploadTicket = m_Transfer.getRecordingTicket();
+	} catch (const std::exception& e) {
+		SERROR("Failed to load model ", request.filepath, ": ", e.what());
+		request.failed = true;
+		return false;
+	}
+
+	return true;
+}
+
+}
@@ -14,6 +14,7 @@ PhysicalDevice::PhysicalDevice(Instance& instance, VkSurfaceKHR surface, VkPhysi
 	physicalDevice
 } {
 	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &p_Properties);
+	vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &p_Features);
 }
 
 PhysicalDevice::~PhysicalDevice() {
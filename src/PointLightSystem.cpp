@@ -1,17 +1,33 @@
 #include "renderer/rendersystems/PointLightSystem.hpp"
 
 #include "Core/Asserts.hpp"
+#include "renderer/wrapper/Swapchain.hpp"
 
 #include <stdexcept>
+#include <algorithm>
 #include <array>
-#include <map>
 
 namespace stl {
 
-PointLightSystem::PointLightSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout)
-	: m_Device{ device } {
+PointLightSystem::PointLightSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, FrameAllocator& frameAllocator)
+	: m_Device{ device }, m_FrameAllocator{ frameAllocator } {
+	createSetLayouts();
 	createPipelineLayout(globalSetLayout);
 	createPipeline(renderPass);
+
+	m_Frames.resize(Swapchain::MAX_FRAMES_IN_FLIGHT);
+
+	for (FrameResources& frame : m_Frames) {
+		frame.clusterBuffer = std::make_unique<Buffer>(m_Device,
+			sizeof(LightClusters::Cluster),
+			m_Clusters.getClusterCount(),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+
+		frame.clusterBuffer->map();
+
+		reserveLights(frame, INITIAL_LIGHT_CAPACITY, INITIAL_LIGHT_CAPACITY);
+	}
 }
 
 PointLightSystem::~PointLightSystem() {
@@ -19,64 +35,196 @@ PointLightSystem::~PointLightSystem() {
 }
 
 void PointLightSystem::update(FrameInfo& frameInfo, GlobalUbo& ubo) {
-	int lightIndex = 0;
+	const auto& lights = frameInfo.scene.getPointLights();
+	const auto& transforms = frameInfo.scene.getTransforms();
+	const glm::mat4& view = frameInfo.camera.getView();
+
+	// lights whose sphere of influence lies outside of the view cannot light anything visible
+	m_InfluenceSpheres.clear();
+
+	for (size_t i = 0; i < lights.size(); i++) {
+		m_InfluenceSpheres.push(transforms.get(lights.getId(i)).getWorldPosition(), lights[i].range);
+	}
+
+	m_Visibility.resize(lights.size());
+	CullingKernel::cullSpheres(Frustum{ frameInfo.camera.getProjection() * view }, m_InfluenceSpheres, m_Visibility.data());
+
+	m_Lights.clear();
+	m_LightSpheres.clear();
+
+	for (size_t i = 0; i < lights.size(); i++) {
+		if (!m_Visibility[i]) continue;
 
-	for (auto& [id, obj] : frameInfo.gameObjects) {
-		if (!obj.p_PointLight.has_value()) continue;
+		const PointLightComponent& light = lights[i];
+		glm::vec3 position{ m_InfluenceSpheres.centerX[i], m_InfluenceSpheres.centerY[i], m_InfluenceSpheres.centerZ[i] };
 
-		ubo.pointLights[lightIndex].position = glm::vec4(obj.p_Transform.translation, 1.0f);
-		ubo.pointLights[lightIndex].color = glm::vec4(obj.p_Color, obj.p_PointLight->lightIntensity);
+		m_Lights.push_back({ glm::vec4(position, light.range), glm::vec4(light.color, light.lightIntensity) });
+		m_LightSpheres.push_back(glm::vec4(glm::vec3(view * glm::vec4(position, 1.0f)), light.range));
+	}
+
+	m_Clusters.setProjection(frameInfo.camera.getProjection());
+	m_Clusters.build(m_LightSpheres);
+
+	const auto& clusters = m_Clusters.getClusters();
+	const auto& lightIndices = m_Clusters.getLightIndices();
 
-		lightIndex++;
+	// the fence of this frame has been waited on, so its buffers are no longer read by the gpu
+	FrameResources& frame = m_Frames[frameInfo.frameIndex];
+	reserveLights(frame, static_cast<uint32_t>(m_Lights.size()), static_cast<uint32_t>(lightIndices.size()));
+
+	if (!m_Lights.empty()) {
+		frame.lightBuffer->writeToBuffer(m_Lights.data(), m_Lights.size() * sizeof(PointLight));
+		frame.lightIndexBuffer->writeToBuffer(lightIndices.data(), lightIndices.size() * sizeof(uint32_t));
 	}
 
-	ubo.numLights = lightIndex;
+	frame.clusterBuffer->writeToBuffer(clusters.data(), clusters.size() * sizeof(LightClusters::Cluster));
+
+	frame.lightBuffer->flush();
+	frame.clusterBuffer->flush();
+	frame.lightIndexBuffer->flush();
+
+	const glm::uvec3& gridSize = m_Clusters.getGridSize();
+	glm::vec2 depthSliceScale = m_Clusters.getDepthSliceScale();
+
+	ubo.clusterScale = {
+		static_cast<float>(gridSize.x) / frameInfo.extent.width,
+		static_cast<float>(gridSize.y) / frameInfo.extent.height,
+		depthSliceScale.x,
+		depthSliceScale.y
+	};
+
+	ubo.clusterGridSize = glm::uvec4(gridSize, 0);
+	ubo.numLights = static_cast<int>(m_Lights.size());
 }
 
 void PointLightSystem::render(FrameInfo& frameInfo) {
-	// sort lights
-	std::map<float, GameObject::id_t> sorted;
-	for (auto& [id, obj] : frameInfo.gameObjects) {
-		if (!obj.p_PointLight.has_value()) continue;
-
-		glm::vec3 offset = frameInfo.camera.getPosition() - obj.p_Transform.translation;
-		float distSquared = glm::dot(offset, offset);
-		sorted[distSquared] = obj.getId();
+	// gather the lights once, then sort them back to front by their distance to the camera
+	const auto& lights = frameInfo.scene.getPointLights();
+	const auto& transforms = frameInfo.scene.getTransforms();
+
+	m_SortedLights.clear();
+	m_SortKeys.clear();
+
+	for (GameObject::id_t id : frameInfo.visibleLights) {
+		const PointLightComponent& light = lights.get(id);
+		const TransformComponent& transform = transforms.get(id);
+
+		glm::vec3 position = transform.getWorldPosition();
+		glm::vec3 offset = frameInfo.camera.getPosition() - position;
+
+		PointLightInstance& instance = m_SortedLights.emplace_back();
+		instance.position = glm::vec4(position, transform.getScale().x);
+		instance.color = glm::vec4(light.color, light.lightIntensity);
+
+		m_SortKeys.push_back({ glm::dot(offset, offset), static_cast<uint32_t>(m_SortKeys.size()) });
+	}
+
+	// lights at the same distance are all kept
+	std::sort(m_SortKeys.begin(), m_SortKeys.end(), [](const LightSortKey& a, const LightSortKey& b) {
+		return a.distanceSquared > b.distanceSquared;
+	});
+
+	uint32_t lightCount = static_cast<uint32_t>(m_SortKeys.size());
+
+	if (lightCount == 0) {
+		return;
 	}
 
 	m_Pipeline->bind(frameInfo.commandBuffer);
 
-	vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
+	// the billboards are split into chunks that fit into the binding range, drawing the chunks and the instances
+	// within them in order keeps the billboards sorted back to front
+	uint32_t chunkCapacity = static_cast<uint32_t>(m_FrameAllocator.getBindingRange() / sizeof(PointLightInstance));
 
-	// iterate through sorted map in reverse order
-	for (auto it = sorted.rbegin(); it != sorted.rend(); ++it) {
-		GameObject& obj = frameInfo.gameObjects.at(it->second);
+	for (uint32_t chunkBegin = 0; chunkBegin < lightCount; chunkBegin += chunkCapacity) {
+		uint32_t chunkSize = std::min(lightCount - chunkBegin, chunkCapacity);
 
-		PointLightPushConstants push{};
-		push.position = glm::vec4(obj.p_Transform.translation, 1.0f);
-		push.color = glm::vec4(obj.p_Color, obj.p_PointLight->lightIntensity);
-		push.radius = obj.p_Transform.scale.x;
+		FrameAllocation allocation = m_FrameAllocator.allocateStorage(chunkSize * sizeof(PointLightInstance));
+		auto* instances = static_cast<PointLightInstance*>(allocation.data);
 
-		vkCmdPushConstants(frameInfo.commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PointLightPushConstants), &push);
+		for (uint32_t i = 0; i < chunkSize; i++) {
+			instances[i] = m_SortedLights[m_SortKeys[chunkBegin + i].light];
+		}
 
-		vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
+		VkDescriptorSet descriptorSets[] = { frameInfo.globalDescriptorSet, allocation.storageSet };
+		uint32_t instanceOffset = static_cast<uint32_t>(allocation.offset);
+		vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 2, descriptorSets, 1, &instanceOffset);
+
+		vkCmdDraw(frameInfo.commandBuffer, 6, chunkSize, 0, 0);
 	}
 }
 
-void PointLightSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout) {
-	VkPushConstantRange pushConstantRange = {};
-	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-	pushConstantRange.offset = 0;
-	pushConstantRange.size = sizeof(PointLightPushConstants);
+void PointLightSystem::reserveLights(FrameResources& frame, uint32_t lightCount, uint32_t indexCount) {
+	auto reserve = [&](std::unique_ptr<Buffer>& buffer, VkDeviceSize instanceSize, uint32_t count) {
+		uint32_t capacity = buffer ? buffer->getInstanceCount() : INITIAL_LIGHT_CAPACITY;
+
+		if (buffer && count <= capacity) {
+			return false;
+		}
+
+		while (capacity < count) {
+			capacity *= 2;
+		}
+
+		buffer = std::make_unique<Buffer>(m_Device,
+			instanceSize,
+			capacity,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
 
-	std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout };
+		buffer->map();
+
+		return true;
+	};
+
+	bool lightsGrown = reserve(frame.lightBuffer, sizeof(PointLight), lightCount);
+	bool indicesGrown = reserve(frame.lightIndexBuffer, sizeof(uint32_t), indexCount);
+
+	if (!lightsGrown && !indicesGrown) {
+		return;
+	}
+
+	auto lightInfo = frame.lightBuffer->descriptorInfo();
+	auto clusterInfo = frame.clusterBuffer->descriptorInfo();
+	auto indexInfo = frame.lightIndexBuffer->descriptorInfo();
+
+	DescriptorWriter writer{ *m_LightSetLayout, *m_DescriptorPool };
+	writer.writeBuffer(0, &lightInfo);
+	writer.writeBuffer(1, &clusterInfo);
+	writer.writeBuffer(2, &indexInfo);
+
+	if (frame.lightDescriptorSet == VK_NULL_HANDLE) {
+		if (!writer.build(frame.lightDescriptorSet)) {
+			throw std::runtime_error("Failed to allocate light descriptor set!");
+		}
+	} else {
+		writer.overwrite(frame.lightDescriptorSet);
+	}
+}
+
+void PointLightSystem::createSetLayouts() {
+	m_LightSetLayout = DescriptorSetLayout::Builder(m_Device)
+		.addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+		.addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+		.addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+		.build();
+
+	// one light set per frame
+	m_DescriptorPool = DescriptorPool::Builder(m_Device)
+		.setMaxSets(Swapchain::MAX_FRAMES_IN_FLIGHT)
+		.addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * Swapchain::MAX_FRAMES_IN_FLIGHT)
+		.build();
+}
+
+void PointLightSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout) {
+	std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout, m_FrameAllocator.getStorageSetLayout() };
 
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
 	pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
-	pipelineLayoutInfo.pushConstantRangeCount = 1;
-	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+	pipelineLayoutInfo.pushConstantRangeCount = 0;
+	pipelineLayoutInfo.pPushConstantRanges = nullptr;
 
 	if (vkCreatePipelineLayout(m_Device.getDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create pipeline layout!");
@@ -96,7 +244,7 @@ void PointLightSystem::createPipeline(VkRenderPass renderPass) {
 	pipelineConfig.renderPass = renderPass;
 	pipelineConfig.pipelineLayout = m_PipelineLayout;
 
-	m_Pipeline = std::make_unique<Pipeline>(m_Device, "shaders/PointLight.vert.spv", "shaders/PointLight.frag.spv", pipelineConfig);
+	m_Pipeline = std::make_unique<Pipeline>(m_Device, SHADER_DIR "/PointLight.vert.spv", SHADER_DIR "/PointLight.frag.spv", pipelineConfig);
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "Rotation.hpp"
+
+namespace stl {
+
+glm::quat Rotation::fromEulerYXZ(const glm::vec3& rotation) {
+	const float cy = glm::cos(rotation.y * 0.5f);
+	const float sy = glm::sin(rotation.y * 0.5f);
+	const float cx = glm::cos(rotation.x * 0.5f);
+	const float sx = glm::sin(rotation.x * 0.5f);
+	const float cz = glm::cos(rotation.z * 0.5f);
+	const float sz = glm::sin(rotation.z * 0.5f);
+
+	// yaw * pitch * roll, expanded
+	return glm::quat{
+		cy * cx * cz + sy * sx * sz,
+		cy * sx * cz + sy * cx * sz,
+		sy * cx * cz - cy * sx * sz,
+		cy * cx * sz - sy * sx * cz
+	};
+}
+
+glm::vec3 Rotation::toEulerYXZ(const glm::quat& orientation) {
+	const glm::mat3 matrix = glm::mat3_cast(orientation);
+
+	// the third column is (cos(pitch) sin(yaw), -sin(pitch), cos(pitch) cos(yaw))
+	const float sinPitch = glm::clamp(-matrix[2][1], -1.0f, 1.0f);
+	const float pitch = glm::asin(sinPitch);
+
+	if (glm::abs(sinPitch) > 0.9999f) {
+		// gimbal lock, only the sum of yaw and roll is defined
+		return { pitch, glm::atan(-matrix[0][2], matrix[0][0]), 0.0f };
+	}
+
+	return { pitch, glm::atan(matrix[2][0], matrix[2][2]), glm::atan(matrix[0][1], matrix[1][1]) };
+}
+
+glm::mat3 Rotation::toMatrixYXZ(const glm::vec3& rotation) {
+	const float c3 = glm::cos(rotation.z);
+	const float s3 = glm::sin(rotation.z);
+	const float c2 = glm::cos(rotation.x);
+	const float s2 = glm::sin(rotation.x);
+	const float c1 = glm::cos(rotation.y);
+	const float s1 = glm::sin(rotation.y);
+
+	return glm::mat3{
+		{ c1 * c3 + s1 * s2 * s3, c2 * s3, c1 * s2 * s3 - c3 * s1 },
+		{ c3 * s1 * s2 - c1 * s3, c2 * c3, c1 * c3 * s2 + s1 * s3 },
+		{ c2 * s1, -s2, c1 * c2 }
+	};
+}
+
+glm::quat Rotation::nlerp(const glm::quat& a, const glm::quat& b, float t) {
+	// q and -q are the same rotation, the one closer to a gives the shorter arc
+	const glm::quat target = glm::dot(a, b) < 0.0f ? -b : b;
+
+	return glm::normalize(a * (1.0f - t) + target * t);
+}
+
+}
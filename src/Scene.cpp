@@ -0,0 +1,60 @@
+#include "Scene.hpp"
+
+#include "Core/Asserts.hpp"
+
+namespace stl {
+
+GameObject Scene::createGameObject() {
+	return createGameObject(m_IdAllocator.allocate());
+}
+
+GameObject Scene::createGameObject(GameObject::id_t reservedId) {
+	SASSERT_MSG(m_IdAllocator.isAlive(reservedId) && !isAlive(reservedId), "Id has not been reserved or is already in use!");
+
+	m_Transforms.add(reservedId);
+
+	return GameObject{ *this, reservedId };
+}
+
+GameObject Scene::createPointLight(float intensity, float radius, glm::vec3 color, float range) {
+	GameObject obj = createGameObject();
+	obj.getTransform().setScale({ radius, 1.0f, 1.0f });
+
+	PointLightComponent& light = m_PointLights.add(obj.getId());
+	light.color = color;
+	light.lightIntensity = intensity;
+	light.range = range;
+
+	return obj;
+}
+
+uint32_t Scene::updateTransforms() {
+	m_UpdatedTransforms.clear();
+	m_TransformUpdateCount++;
+
+	// the hierarchy has to see which transforms changed, so it runs first
+	m_Hierarchy.update(&m_UpdatedTransforms);
+
+	for (size_t i = 0; i < m_Transforms.size(); i++) {
+		TransformComponent& transform = m_Transforms[i];
+
+		if (!transform.m_Changed) continue;
+
+		transform.updateMatrices();
+		transform.m_Changed = false;
+		m_UpdatedTransforms.push_back(m_Transforms.getId(i));
+	}
+
+	return static_cast<uint32_t>(m_UpdatedTransforms.size());
+}
+
+void Scene::destroyGameObject(GameObject::id_t id) {
+	m_Hierarchy.remove(id);
+	m_Models.remove(id);
+	m_PointLights.remove(id);
+	m_Transforms.remove(id);
+
+	m_IdAllocator.free(id);
+}
+
+}
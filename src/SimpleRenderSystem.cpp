@@ -2,14 +2,18 @@
 
 #include "Core/Asserts.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
 #include <array>
 
 namespace stl {
 
-SimpleRenderSystem::SimpleRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout)
-	: m_Device{ device } {
-	createPipelineLayout(globalSetLayout);
+SimpleRenderSystem::SimpleRenderSystem(Device& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout lightSetLayout, FrameAllocator& frameAllocator)
+	: m_Device{ device }, m_FrameAllocator{ frameAllocator } {
+	setIndirectEnabled(true);
+
+	createPipelineLayout(globalSetLayout, lightSetLayout);
 	createPipeline(renderPass);
 }
 
@@ -18,38 +22,128 @@ SimpleRenderSystem::~SimpleRenderSystem() {
 }
 
 void SimpleRenderSystem::renderGameObjects(FrameInfo& frameInfo) {
+	m_DrawItems.clear();
+
+	const auto& models = frameInfo.scene.getModels();
+	const auto& transforms = frameInfo.scene.getTransforms();
+
+	for (GameObject::id_t id : frameInfo.visibleObjects) {
+		m_DrawItems.push_back({ models.get(id).model.get(), &transforms.get(id) });
+	}
+
+	// objects sharing a model end up next to each other and are drawn as instances of one draw
+	std::sort(m_DrawItems.begin(), m_DrawItems.end(), [](const DrawItem& a, const DrawItem& b) {
+		const GeometryPool* poolA = &a.model->getGeometryPool();
+		const GeometryPool* poolB = &b.model->getGeometryPool();
+
+		if (poolA != poolB) return std::less<const GeometryPool*>{}(poolA, poolB);
+
+		return std::less<const Model*>{}(a.model, b.model);
+	});
+
+	if (m_DrawItems.empty()) {
+		return;
+	}
+
 	m_Pipeline->bind(frameInfo.commandBuffer);
 
-	vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 1, &frameInfo.globalDescriptorSet, 0, nullptr);
+	// models share the buffers of their pool, so they only need to be bound when the pool changes
+	const GeometryPool* boundPool = nullptr;
+
+	// the object data is split into chunks that fit into the binding range, each bound with its own dynamic offset
+	size_t chunkCapacity = m_FrameAllocator.getBindingRange() / sizeof(SimpleObjectData);
+
+	for (size_t chunkBegin = 0; chunkBegin < m_DrawItems.size(); chunkBegin += chunkCapacity) {
+		size_t chunkEnd = std::min(m_DrawItems.size(), chunkBegin + chunkCapacity);
+		size_t chunkSize = chunkEnd - chunkBegin;
+
+		FrameAllocation objectAllocation = m_FrameAllocator.allocateStorage(chunkSize * sizeof(SimpleObjectData));
+		FrameAllocation commandAllocation = m_FrameAllocator.allocate(chunkSize * sizeof(VkDrawIndexedIndirectCommand), alignof(VkDrawIndexedIndirectCommand));
+
+		auto* objects = static_cast<SimpleObjectData*>(objectAllocation.data);
+		auto* commands = static_cast<VkDrawIndexedIndirectCommand*>(commandAllocation.data);
+
+		VkDescriptorSet descriptorSets[] = { frameInfo.globalDescriptorSet, objectAllocation.storageSet, frameInfo.lightDescriptorSet };
+		uint32_t objectOffset = static_cast<uint32_t>(objectAllocation.offset);
+		vkCmdBindDescriptorSets(frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout, 0, 3, descriptorSets, 1, &objectOffset);
+
+		uint32_t objectIndex = 0;
+		uint32_t commandCount = 0;
+		uint32_t firstCommand = 0;
 
-	for (auto& [id, obj] : frameInfo.gameObjects) {
-		if (obj.p_Model == nullptr) continue;
+		// instances of a model that span two chunks become one draw in each
+		for (size_t i = chunkBegin; i < chunkEnd;) {
+			const Model* model = m_DrawItems[i].model;
 
-		SimplePushConstantData push = {};
-		push.modelMatrix = obj.p_Transform.modelMatrix();
-		push.normalMatrix = obj.p_Transform.normalMatrix();
+			if (&model->getGeometryPool() != boundPool) {
+				recordDraws(frameInfo.commandBuffer, commandAllocation, firstCommand, commandCount - firstCommand);
+				firstCommand = commandCount;
 
-		vkCmdPushConstants(frameInfo.commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SimplePushConstantData), &push);
+				boundPool = &model->getGeometryPool();
+				boundPool->bind(frameInfo.commandBuffer);
+			}
 
-		obj.p_Model->bind(frameInfo.commandBuffer);
-		obj.p_Model->draw(frameInfo.commandBuffer);
+			uint32_t firstInstance = objectIndex;
+
+			for (; i < chunkEnd && m_DrawItems[i].model == model; i++) {
+				const TransformComponent& transform = *m_DrawItems[i].transform;
+
+				objects[objectIndex].modelMatrix = transform.getWorldMatrix();
+				objects[objectIndex].normalMatrix = transform.getWorldNormalMatrix();
+
+				objectIndex++;
+			}
+
+			uint32_t instanceCount = objectIndex - firstInstance;
+
+			if (model->hasIndexBuffer()) {
+				commands[commandCount++] = model->getDrawCommand(firstInstance, instanceCount);
+			} else {
+				model->draw(frameInfo.commandBuffer, firstInstance, instanceCount);
+			}
+		}
+
+		recordDraws(frameInfo.commandBuffer, commandAllocation, firstCommand, commandCount - firstCommand);
 	}
 }
 
-void SimpleRenderSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout) {
-	VkPushConstantRange pushConstantRange = {};
-	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-	pushConstantRange.offset = 0;
-	pushConstantRange.size = sizeof(SimplePushConstantData);
+void SimpleRenderSystem::recordDraws(VkCommandBuffer commandBuffer, const FrameAllocation& commands, uint32_t firstCommand, uint32_t commandCount) {
+	if (commandCount == 0) {
+		return;
+	}
+
+	constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+	if (!m_IndirectEnabled) {
+		auto* draws = static_cast<const VkDrawIndexedIndirectCommand*>(commands.data);
+
+		for (uint32_t i = firstCommand; i < firstCommand + commandCount; i++) {
+			vkCmdDrawIndexed(commandBuffer, draws[i].indexCount, draws[i].instanceCount, draws[i].firstIndex, draws[i].vertexOffset, draws[i].firstInstance);
+		}
+
+		return;
+	}
+
+	VkDeviceSize offset = commands.offset + static_cast<VkDeviceSize>(firstCommand) * stride;
+
+	if (m_Device.p_Features.multiDrawIndirect) {
+		vkCmdDrawIndexedIndirect(commandBuffer, commands.buffer, offset, commandCount, stride);
+	} else {
+		for (uint32_t i = 0; i < commandCount; i++) {
+			vkCmdDrawIndexedIndirect(commandBuffer, commands.buffer, offset + i * stride, 1, stride);
+		}
+	}
+}
 
-	std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout };
+void SimpleRenderSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout lightSetLayout) {
+	std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout, m_FrameAllocator.getStorageSetLayout(), lightSetLayout };
 
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
 	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
 	pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
-	pipelineLayoutInfo.pushConstantRangeCount = 1;
-	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+	pipelineLayoutInfo.pushConstantRangeCount = 0;
+	pipelineLayoutInfo.pPushConstantRanges = nullptr;
 
 	if (vkCreatePipelineLayout(m_Device.getDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS) {
 		throw std::runtime_error("Failed to create pipeline layout!");
@@ -65,7 +159,7 @@ void SimpleRenderSystem::createPipeline(VkRenderPass renderPass) {
 	pipelineConfig.renderPass = renderPass;
 	pipelineConfig.pipelineLayout = m_PipelineLayout;
 
-	m_Pipeline = std::make_unique<Pipeline>(m_Device, "shaders/SimpleShader.vert.spv", "shaders/SimpleShader.frag.spv", pipelineConfig);
+	m_Pipeline = std::make_unique<Pipeline>(m_Device, SHADER_DIR "/SimpleShader.vert.spv", SHADER_DIR "/SimpleShader.frag.spv", pipelineConfig);
 }
 
 }
\ No newline at end of file
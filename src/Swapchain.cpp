@@ -38,7 +38,7 @@ Swapchain::~Swapchain() {
 	for (size_t i = 0; i < m_DepthImages.size(); i++) {
 		vkDestroyImageView(m_Device.getDevice(), m_DepthImageViews[i], nullptr);
 		vkDestroyImage(m_Device.getDevice(), m_DepthImages[i], nullptr);
-		vkFreeMemory(m_Device.getDevice(), m_DepthImageMemories[i], nullptr);
+		m_Device.getAllocator().free(m_DepthImageAllocations[i]);
 	}
 
 	for (auto framebuffer : m_SwapchainFramebuffers) {
@@ -204,7 +204,7 @@ void Swapchain::createDepthResources() {
 	VkExtent2D swapchainExtent = getSwapchainExtent();
 
 	m_DepthImages.resize(imageCount());
-	m_DepthImageMemories.resize(imageCount());
+	m_DepthImageAllocations.resize(imageCount());
 	m_DepthImageViews.resize(imageCount());
 
 	for (size_t i = 0; i < imageCount(); i++) {
@@ -224,7 +224,7 @@ void Swapchain::createDepthResources() {
 		imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 		imageInfo.flags = 0;
 
-		m_Device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_DepthImages[i], m_DepthImageMemories[i]);
+		m_Device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_DepthImages[i], m_DepthImageAllocations[i]);
 
 		VkImageViewCreateInfo viewInfo = {};
 		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -0,0 +1,130 @@
+#include "Core/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace stl {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+	m_Workers.reserve(threadCount);
+
+	for (size_t i = 0; i < threadCount; i++) {
+		m_Workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock{ m_Mutex };
+		m_Stopping = true;
+	}
+
+	m_Condition.notify_all();
+
+	for (std::thread& worker : m_Workers) {
+		worker.join();
+	}
+}
+
+ThreadPool& ThreadPool::get() {
+	static ThreadPool pool{ std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+	return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& func) {
+	if (count == 0) {
+		return;
+	}
+
+	if (count == 1 || m_Workers.empty()) {
+		for (size_t i = 0; i < count; i++) {
+			func(i);
+		}
+
+		return;
+	}
+
+	// shared so that helpers which only start after all work is done can still exit safely
+	struct State {
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> done{ 0 };
+		size_t count;
+		const std::function<void(size_t)>* func;
+
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr error;
+	};
+
+	auto state = std::make_shared<State>();
+	state->count = count;
+	state->func = &func;
+
+	auto work = [state]() {
+		size_t i;
+
+		while ((i = state->next.fetch_add(1)) < state->count) {
+			try {
+				(*state->func)(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock{ state->mutex };
+
+				if (!state->error) {
+					state->error = std::current_exception();
+				}
+			}
+
+			if (state->done.fetch_add(1) + 1 == state->count) {
+				std::lock_guard<std::mutex> lock{ state->mutex };
+				state->finished.notify_all();
+			}
+		}
+	};
+
+	size_t helperCount = std::min(count - 1, m_Workers.size());
+
+	for (size_t i = 0; i < helperCount; i++) {
+		enqueue(work);
+	}
+
+	work();
+
+	std::unique_lock<std::mutex> lock{ state->mutex };
+	state->finished.wait(lock, [&]() { return state->done.load() == count; });
+
+	if (state->error) {
+		std::rethrow_exception(state->error);
+	}
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock{ m_Mutex };
+		m_Tasks.push(std::move(task));
+	}
+
+	m_Condition.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+	while (true) {
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock{ m_Mutex };
+			m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+
+			if (m_Stopping && m_Tasks.empty()) {
+				return;
+			}
+
+			task = std::move(m_Tasks.front());
+			m_Tasks.pop();
+		}
+
+		task();
+	}
+}
+
+}
@@ -0,0 +1,206 @@
+#include "renderer/wrapper/TransferContext.hpp"
+
+#include "Core/Asserts.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace stl {
+
+TransferContext::TransferContext(Device& device, VkDeviceSize stagingSize)
+	: m_Device{ device }, m_StagingSize{ stagingSize } {
+	m_StagingBuffer = std::make_unique<Buffer>(m_Device,
+		1,
+		static_cast<uint32_t>(m_StagingSize),
+		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	m_StagingBuffer->map();
+}
+
+TransferContext::~TransferContext() {
+	waitIdle();
+
+	for (const Batch& batch : m_FreeBatches) {
+		vkDestroyFence(m_Device.getDevice(), batch.fence, nullptr);
+		vkFreeCommandBuffers(m_Device.getDevice(), m_Device.getCommandPool(), 1, &batch.commandBuffer);
+	}
+}
+
+uint64_t TransferContext::upload(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset) {
+	const char* bytes = static_cast<const char*>(data);
+
+	// large uploads are split so that they never need the whole ring at once
+	const VkDeviceSize maxChunkSize = m_StagingSize / 4;
+
+	while (size > 0) {
+		VkDeviceSize chunkSize = std::min(size, maxChunkSize);
+		VkDeviceSize srcOffset = allocateStaging(chunkSize);
+
+		memcpy(static_cast<char*>(m_StagingBuffer->getMappedMemory()) + srcOffset, bytes, chunkSize);
+
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = srcOffset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = chunkSize;
+
+		vkCmdCopyBuffer(getCommandBuffer(), m_StagingBuffer->getBuffer(), dstBuffer, 1, &copyRegion);
+
+		bytes += chunkSize;
+		dstOffset += chunkSize;
+		size -= chunkSize;
+	}
+
+	return m_NextTicket;
+}
+
+uint64_t TransferContext::submit() {
+	if (m_Recording.commandBuffer == VK_NULL_HANDLE) {
+		return m_NextTicket - 1;
+	}
+
+	// make the copies visible to everything submitted to the queue afterwards
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+	vkCmdPipelineBarrier(m_Recording.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+	if (vkEndCommandBuffer(m_Recording.commandBuffer) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to record transfer command buffer!");
+	}
+
+	VkSubmitInfo submitInfo = {};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &m_Recording.commandBuffer;
+
+	if (vkQueueSubmit(m_Device.getGraphicsQueue(), 1, &submitInfo, m_Recording.fence) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to submit transfer command buffer!");
+	}
+
+	m_Recording.ticket = m_NextTicket++;
+	m_Recording.stagingEnd = m_Head;
+
+	m_InFlight.push_back(m_Recording);
+	m_Recording = { VK_NULL_HANDLE, VK_NULL_HANDLE, 0, 0 };
+
+	return m_NextTicket - 1;
+}
+
+bool TransferContext::isComplete(uint64_t ticket) {
+	retire(false);
+
+	return ticket <= m_CompletedTicket;
+}
+
+void TransferContext::wait(uint64_t ticket) {
+	if (ticket >= m_NextTicket) {
+		submit();
+	}
+
+	while (m_CompletedTicket < ticket && !m_InFlight.empty()) {
+		retire(true);
+	}
+}
+
+void TransferContext::waitIdle() {
+	submit();
+
+	while (!m_InFlight.empty()) {
+		retire(true);
+	}
+}
+
+VkDeviceSize TransferContext::allocateStaging(VkDeviceSize size) {
+	SASSERT_MSG(size <= m_StagingSize, "Staging allocation is larger than the ring");
+
+	while (true) {
+		if (m_Head == m_Tail) {
+			// the ring is empty, restart at its beginning
+			m_Head = m_Tail = (m_Head + m_StagingSize - 1) / m_StagingSize * m_StagingSize;
+		}
+
+		uint64_t offset = (m_Head + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+
+		// allocations never wrap around the end of the ring
+		if (offset % m_StagingSize + size > m_StagingSize) {
+			offset += m_StagingSize - offset % m_StagingSize;
+		}
+
+		if (offset + size - m_Tail <= m_StagingSize) {
+			m_Head = offset + size;
+			return offset % m_StagingSize;
+		}
+
+		// the space is held by the batch that is still being recorded
+		if (m_InFlight.empty()) {
+			submit();
+		}
+
+		retire(true);
+	}
+}
+
+VkCommandBuffer TransferContext::getCommandBuffer() {
+	if (m_Recording.commandBuffer != VK_NULL_HANDLE) {
+		return m_Recording.commandBuffer;
+	}
+
+	if (!m_FreeBatches.empty()) {
+		m_Recording = m_FreeBatches.back();
+		m_FreeBatches.pop_back();
+	} else {
+		VkCommandBufferAllocateInfo allocInfo = {};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = m_Device.getCommandPool();
+		allocInfo.commandBufferCount = 1;
+
+		if (vkAllocateCommandBuffers(m_Device.getDevice(), &allocInfo, &m_Recording.commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to allocate transfer command buffer!");
+		}
+
+		VkFenceCreateInfo fenceInfo = {};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+		if (vkCreateFence(m_Device.getDevice(), &fenceInfo, nullptr, &m_Recording.fence) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to create transfer fence!");
+		}
+	}
+
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if (vkBeginCommandBuffer(m_Recording.commandBuffer, &beginInfo) != VK_SUCCESS) {
+		throw std::runtime_error("Failed to begin transfer command buffer!");
+	}
+
+	return m_Recording.commandBuffer;
+}
+
+void TransferContext::retire(bool block) {
+	while (!m_InFlight.empty()) {
+		Batch& batch = m_InFlight.front();
+
+		if (block) {
+			vkWaitForFences(m_Device.getDevice(), 1, &batch.fence, VK_TRUE, UINT64_MAX);
+			block = false;
+		} else if (vkGetFenceStatus(m_Device.getDevice(), batch.fence) != VK_SUCCESS) {
+			break;
+		}
+
+		vkResetFences(m_Device.getDevice(), 1, &batch.fence);
+
+		m_Tail = batch.stagingEnd;
+		m_CompletedTicket = batch.ticket;
+
+		m_FreeBatches.push_back(batch);
+		m_InFlight.pop_front();
+	}
+}
+
+}
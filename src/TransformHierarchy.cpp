@@ -0,0 +1,203 @@
+#include "TransformHierarchy.hpp"
+
+#include "Core/Asserts.hpp"
+
+#include <stdexcept>
+
+namespace stl {
+
+TransformHierarchy::TransformHierarchy(ComponentStore<TransformComponent>& transforms)
+	: m_Transforms{ transforms } {
+}
+
+void TransformHierarchy::setParent(id_t child, id_t parent) {
+	SASSERT_MSG(m_Transforms.contains(child) && m_Transforms.contains(parent), "Both objects need a transform!");
+
+	for (id_t ancestor = parent; ancestor != INVALID_ID;) {
+		if (ancestor == child) {
+			throw std::runtime_error("Failed to set parent, the object is an ancestor of its new parent!");
+		}
+
+		const Node* node = m_Nodes.tryGet(ancestor);
+		ancestor = node != nullptr ? node->parent : INVALID_ID;
+	}
+
+	if (const Node* node = m_Nodes.tryGet(child); node != nullptr && node->parent != INVALID_ID) {
+		unlink(child);
+	}
+
+	// adding may move the nodes, so they are only looked up afterwards
+	if (!m_Nodes.contains(child)) m_Nodes.add(child);
+	if (!m_Nodes.contains(parent)) m_Nodes.add(parent);
+
+	Node& childNode = m_Nodes.get(child);
+	Node& parentNode = m_Nodes.get(parent);
+
+	childNode.parent = parent;
+	childNode.nextSibling = parentNode.firstChild;
+
+	if (parentNode.firstChild != INVALID_ID) {
+		m_Nodes.get(parentNode.firstChild).previousSibling = child;
+	}
+
+	parentNode.firstChild = child;
+
+	m_Transforms.get(child).m_HasParent = true;
+	m_OrderDirty = true;
+}
+
+void TransformHierarchy::removeParent(id_t child) {
+	const Node* node = m_Nodes.tryGet(child);
+
+	if (node == nullptr || node->parent == INVALID_ID) return;
+
+	unlink(child);
+	removeIfIsolated(child);
+
+	m_OrderDirty = true;
+}
+
+void TransformHierarchy::remove(id_t id) {
+	if (!m_Nodes.contains(id)) return;
+
+	if (m_Nodes.get(id).parent != INVALID_ID) {
+		unlink(id);
+	}
+
+	for (id_t child = m_Nodes.get(id).firstChild; child != INVALID_ID;) {
+		Node& childNode = m_Nodes.get(child);
+		id_t next = childNode.nextSibling;
+
+		childNode.parent = INVALID_ID;
+		childNode.nextSibling = INVALID_ID;
+		childNode.previousSibling = INVALID_ID;
+		m_Transforms.get(child).m_HasParent = false;
+
+		removeIfIsolated(child);
+		child = next;
+	}
+
+	m_Nodes.remove(id);
+	m_OrderDirty = true;
+}
+
+std::optional<TransformHierarchy::id_t> TransformHierarchy::getParent(id_t id) const {
+	const Node* node = m_Nodes.tryGet(id);
+
+	if (node == nullptr || node->parent == INVALID_ID) return std::nullopt;
+
+	return node->parent;
+}
+
+void TransformHierarchy::getChildren(id_t id, std::vector<id_t>& children) const {
+	const Node* node = m_Nodes.tryGet(id);
+
+	if (node == nullptr) return;
+
+	for (id_t child = node->firstChild; child != INVALID_ID; child = m_Nodes.get(child).nextSibling) {
+		children.push_back(child);
+	}
+}
+
+uint32_t TransformHierarchy::update(std::vector<id_t>* updated) {
+	// a new structure recomputes everything, as any object may have a new parent
+	bool updateAll = m_OrderDirty;
+
+	if (m_OrderDirty) {
+		rebuildOrder();
+		m_OrderDirty = false;
+	}
+
+	uint32_t updatedCount = 0;
+
+	for (size_t slot = 0; slot < m_Order.size(); slot++) {
+		SASSERT_MSG(m_Transforms.getId(slot) == m_Order[slot], "Transform store was reordered outside of the hierarchy!");
+
+		TransformComponent& transform = m_Transforms[slot];
+		uint32_t parentSlot = m_ParentSlots[slot];
+
+		bool changed = updateAll || transform.m_Changed || (parentSlot != INVALID_SLOT && m_Changed[parentSlot]);
+		m_Changed[slot] = changed;
+
+		if (!changed) continue;
+
+		transform.updateMatrices();
+		transform.m_Changed = false;
+		updatedCount++;
+
+		if (updated != nullptr) {
+			updated->push_back(m_Order[slot]);
+		}
+
+		if (parentSlot == INVALID_SLOT) continue;
+
+		// parents come first in the order, so their world matrices are already up to date
+		const TransformComponent& parent = m_Transforms[parentSlot];
+
+		transform.m_WorldMatrix = parent.getWorldMatrix() * transform.getModelMatrix();
+		transform.m_WorldNormalMatrix = parent.getWorldNormalMatrix() * transform.getNormalMatrix();
+	}
+
+	return updatedCount;
+}
+
+void TransformHierarchy::unlink(id_t child) {
+	Node& node = m_Nodes.get(child);
+	id_t parent = node.parent;
+
+	if (node.previousSibling != INVALID_ID) {
+		m_Nodes.get(node.previousSibling).nextSibling = node.nextSibling;
+	} else {
+		m_Nodes.get(parent).firstChild = node.nextSibling;
+	}
+
+	if (node.nextSibling != INVALID_ID) {
+		m_Nodes.get(node.nextSibling).previousSibling = node.previousSibling;
+	}
+
+	node.parent = INVALID_ID;
+	node.nextSibling = INVALID_ID;
+	node.previousSibling = INVALID_ID;
+
+	m_Transforms.get(child).m_HasParent = false;
+
+	removeIfIsolated(parent);
+}
+
+void TransformHierarchy::removeIfIsolated(id_t id) {
+	const Node* node = m_Nodes.tryGet(id);
+
+	if (node != nullptr && node->parent == INVALID_ID && node->firstChild == INVALID_ID) {
+		m_Nodes.remove(id);
+	}
+}
+
+void TransformHierarchy::rebuildOrder() {
+	m_Order.clear();
+	m_ParentSlots.clear();
+
+	for (size_t i = 0; i < m_Nodes.size(); i++) {
+		if (m_Nodes[i].parent != INVALID_ID) continue;
+
+		m_Order.push_back(m_Nodes.getId(i));
+		m_ParentSlots.push_back(INVALID_SLOT);
+	}
+
+	// the order doubles as the queue of the breadth first traversal
+	for (size_t slot = 0; slot < m_Order.size(); slot++) {
+		for (id_t child = m_Nodes.get(m_Order[slot]).firstChild; child != INVALID_ID; child = m_Nodes.get(child).nextSibling) {
+			m_Order.push_back(child);
+			m_ParentSlots.push_back(static_cast<uint32_t>(slot));
+		}
+	}
+
+	// objects outside of the hierarchy only ever move within the back of the store, so the front stays sorted until
+	// the structure changes again
+	for (size_t slot = 0; slot < m_Order.size(); slot++) {
+		m_Transforms.swapPositions(slot, m_Transforms.getIndex(m_Order[slot]));
+	}
+
+	m_Changed.assign(m_Order.size(), 0);
+}
+
+}
@@ -0,0 +1,350 @@
+#include "TransformKernel.hpp"
+
+#include "Core/Common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TRANSFORM_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#endif
+
+namespace stl {
+
+namespace {
+
+// inputs in the order of TransformArrays
+enum Input { TranslationX, TranslationY, TranslationZ, RotationX, RotationY, RotationZ, ScaleX, ScaleY, ScaleZ, InputCount };
+
+// 9 model terms, 9 normal terms, both column major
+constexpr int TERM_COUNT = 18;
+
+template<size_t W>
+struct Block {
+	alignas(32) float inputs[InputCount][W];
+	alignas(32) float terms[TERM_COUNT][W];
+};
+
+template<size_t W>
+void loadBlock(const TransformArrays& transforms, size_t first, size_t count, Block<W>& block) {
+	const std::vector<float>* arrays[InputCount] = {
+		&transforms.translationX, &transforms.translationY, &transforms.translationZ,
+		&transforms.rotationX, &transforms.rotationY, &transforms.rotationZ,
+		&transforms.scaleX, &transforms.scaleY, &transforms.scaleZ
+	};
+
+	for (int input = 0; input < InputCount; input++) {
+		std::copy_n(arrays[input]->data() + first, count, block.inputs[input]);
+
+		// padding lanes get an identity transform, so that they never divide by zero
+		std::fill(block.inputs[input] + count, block.inputs[input] + W, input >= ScaleX ? 1.0f : 0.0f);
+	}
+}
+
+template<size_t W>
+void storeBlock(const Block<W>& block, size_t first, size_t count, glm::mat4* modelMatrices, glm::mat3* normalMatrices) {
+	const auto& t = block.terms;
+	const auto& in = block.inputs;
+
+	for (size_t lane = 0; lane < count; lane++) {
+		modelMatrices[first + lane] = glm::mat4{
+			{ t[0][lane], t[1][lane], t[2][lane], 0.0f },
+			{ t[3][lane], t[4][lane], t[5][lane], 0.0f },
+			{ t[6][lane], t[7][lane], t[8][lane], 0.0f },
+			{ in[TranslationX][lane], in[TranslationY][lane], in[TranslationZ][lane], 1.0f }
+		};
+
+		normalMatrices[first + lane] = glm::mat3{
+			{ t[9][lane], t[10][lane], t[11][lane] },
+			{ t[12][lane], t[13][lane], t[14][lane] },
+			{ t[15][lane], t[16][lane], t[17][lane] }
+		};
+	}
+}
+
+// same expressions as TransformComponent::modelMatrix() and normalMatrix()
+void computeScalar(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices) {
+	for (size_t i = 0; i < transforms.size(); i++) {
+		const float c3 = std::cos(transforms.rotationZ[i]);
+		const float s3 = std::sin(transforms.rotationZ[i]);
+		const float c2 = std::cos(transforms.rotationX[i]);
+		const float s2 = std::sin(transforms.rotationX[i]);
+		const float c1 = std::cos(transforms.rotationY[i]);
+		const float s1 = std::sin(transforms.rotationY[i]);
+
+		const glm::vec3 scale{ transforms.scaleX[i], transforms.scaleY[i], transforms.scaleZ[i] };
+		const glm::vec3 invScale = 1.0f / scale;
+
+		const glm::vec3 x{ c1 * c3 + s1 * s2 * s3, c2 * s3, c1 * s2 * s3 - c3 * s1 };
+		const glm::vec3 y{ c3 * s1 * s2 - c1 * s3, c2 * c3, c1 * c3 * s2 + s1 * s3 };
+		const glm::vec3 z{ c2 * s1, -s2, c1 * c2 };
+
+		modelMatrices[i] = glm::mat4{
+			glm::vec4(scale.x * x, 0.0f),
+			glm::vec4(scale.y * y, 0.0f),
+			glm::vec4(scale.z * z, 0.0f),
+			glm::vec4(transforms.translationX[i], transforms.translationY[i], transforms.translationZ[i], 1.0f)
+		};
+
+		normalMatrices[i] = glm::mat3{ invScale.x * x, invScale.y * y, invScale.z * z };
+	}
+}
+
+#if TRANSFORM_X86
+
+// range reduction to [-pi/4, pi/4] in three steps followed by the cephes minimax polynomials
+constexpr float FOUR_OVER_PI = 1.27323954473516f;
+constexpr float DP1 = -0.78515625f;
+constexpr float DP2 = -2.4187564849853515625e-4f;
+constexpr float DP3 = -3.77489497744594108e-8f;
+
+constexpr float SIN_P0 = -1.9515295891e-4f;
+constexpr float SIN_P1 = 8.3321608736e-3f;
+constexpr float SIN_P2 = -1.6666654611e-1f;
+constexpr float COS_P0 = 2.443315711809948e-5f;
+constexpr float COS_P1 = -1.388731625493765e-3f;
+constexpr float COS_P2 = 4.166664568298827e-2f;
+
+TARGET_SSE inline void sinCosSSE(__m128 x, __m128& sin, __m128& cos) {
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+
+	__m128 sinSign = _mm_and_ps(x, signMask);
+	x = _mm_andnot_ps(signMask, x);
+
+	// octant, rounded up to an even number
+	__m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOUR_OVER_PI)));
+	octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+	__m128 y = _mm_cvtepi32_ps(octant);
+
+	__m128 swapSinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+	__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+	__m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP1)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP2)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP3)));
+
+	sinSign = _mm_xor_ps(sinSign, swapSinSign);
+
+	__m128 z = _mm_mul_ps(x, x);
+
+	__m128 cosPoly = _mm_set1_ps(COS_P0);
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(COS_P1));
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(COS_P2));
+	cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+	cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+	__m128 sinPoly = _mm_set1_ps(SIN_P0);
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SIN_P1));
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(SIN_P2));
+	sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+	// odd octant pairs swap sine and cosine
+	__m128 sinValue = _mm_or_ps(_mm_and_ps(polyMask, sinPoly), _mm_andnot_ps(polyMask, cosPoly));
+	__m128 cosValue = _mm_or_ps(_mm_and_ps(polyMask, cosPoly), _mm_andnot_ps(polyMask, sinPoly));
+
+	sin = _mm_xor_ps(sinValue, sinSign);
+	cos = _mm_xor_ps(cosValue, cosSign);
+}
+
+TARGET_SSE void computeBlockSSE(Block<4>& block) {
+	__m128 s1, c1, s2, c2, s3, c3;
+	sinCosSSE(_mm_load_ps(block.inputs[RotationX]), s2, c2);
+	sinCosSSE(_mm_load_ps(block.inputs[RotationY]), s1, c1);
+	sinCosSSE(_mm_load_ps(block.inputs[RotationZ]), s3, c3);
+
+	__m128 rotation[9];
+	rotation[0] = _mm_add_ps(_mm_mul_ps(c1, c3), _mm_mul_ps(_mm_mul_ps(s1, s2), s3));
+	rotation[1] = _mm_mul_ps(c2, s3);
+	rotation[2] = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c1, s2), s3), _mm_mul_ps(c3, s1));
+	rotation[3] = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c3, s1), s2), _mm_mul_ps(c1, s3));
+	rotation[4] = _mm_mul_ps(c2, c3);
+	rotation[5] = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(c1, c3), s2), _mm_mul_ps(s1, s3));
+	rotation[6] = _mm_mul_ps(c2, s1);
+	rotation[7] = _mm_sub_ps(_mm_setzero_ps(), s2);
+	rotation[8] = _mm_mul_ps(c1, c2);
+
+	for (int axis = 0; axis < 3; axis++) {
+		__m128 scale = _mm_load_ps(block.inputs[ScaleX + axis]);
+		__m128 invScale = _mm_div_ps(_mm_set1_ps(1.0f), scale);
+
+		for (int row = 0; row < 3; row++) {
+			_mm_store_ps(block.terms[axis * 3 + row], _mm_mul_ps(scale, rotation[axis * 3 + row]));
+			_mm_store_ps(block.terms[9 + axis * 3 + row], _mm_mul_ps(invScale, rotation[axis * 3 + row]));
+		}
+	}
+}
+
+TARGET_AVX2 inline void sinCosAVX2(__m256 x, __m256& sin, __m256& cos) {
+	const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000)));
+
+	__m256 sinSign = _mm256_and_ps(x, signMask);
+	x = _mm256_andnot_ps(signMask, x);
+
+	__m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(FOUR_OVER_PI)));
+	octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+	__m256 y = _mm256_cvtepi32_ps(octant);
+
+	__m256 swapSinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29));
+	__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+	__m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+
+	x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP1)));
+	x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP2)));
+	x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP3)));
+
+	sinSign = _mm256_xor_ps(sinSign, swapSinSign);
+
+	__m256 z = _mm256_mul_ps(x, x);
+
+	__m256 cosPoly = _mm256_set1_ps(COS_P0);
+	cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(COS_P1));
+	cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(COS_P2));
+	cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+	cosPoly = _mm256_sub_ps(cosPoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+	cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+	__m256 sinPoly = _mm256_set1_ps(SIN_P0);
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(SIN_P1));
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(SIN_P2));
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x), x);
+
+	__m256 sinValue = _mm256_blendv_ps(cosPoly, sinPoly, polyMask);
+	__m256 cosValue = _mm256_blendv_ps(sinPoly, cosPoly, polyMask);
+
+	sin = _mm256_xor_ps(sinValue, sinSign);
+	cos = _mm256_xor_ps(cosValue, cosSign);
+}
+
+TARGET_AVX2 void computeBlockAVX2(Block<8>& block) {
+	__m256 s1, c1, s2, c2, s3, c3;
+	sinCosAVX2(_mm256_load_ps(block.inputs[RotationX]), s2, c2);
+	sinCosAVX2(_mm256_load_ps(block.inputs[RotationY]), s1, c1);
+	sinCosAVX2(_mm256_load_ps(block.inputs[RotationZ]), s3, c3);
+
+	__m256 rotation[9];
+	rotation[0] = _mm256_add_ps(_mm256_mul_ps(c1, c3), _mm256_mul_ps(_mm256_mul_ps(s1, s2), s3));
+	rotation[1] = _mm256_mul_ps(c2, s3);
+	rotation[2] = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(c1, s2), s3), _mm256_mul_ps(c3, s1));
+	rotation[3] = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(c3, s1), s2), _mm256_mul_ps(c1, s3));
+	rotation[4] = _mm256_mul_ps(c2, c3);
+	rotation[5] = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(c1, c3), s2), _mm256_mul_ps(s1, s3));
+	rotation[6] = _mm256_mul_ps(c2, s1);
+	rotation[7] = _mm256_sub_ps(_mm256_setzero_ps(), s2);
+	rotation[8] = _mm256_mul_ps(c1, c2);
+
+	for (int axis = 0; axis < 3; axis++) {
+		__m256 scale = _mm256_load_ps(block.inputs[ScaleX + axis]);
+		__m256 invScale = _mm256_div_ps(_mm256_set1_ps(1.0f), scale);
+
+		for (int row = 0; row < 3; row++) {
+			_mm256_store_ps(block.terms[axis * 3 + row], _mm256_mul_ps(scale, rotation[axis * 3 + row]));
+			_mm256_store_ps(block.terms[9 + axis * 3 + row], _mm256_mul_ps(invScale, rotation[axis * 3 + row]));
+		}
+	}
+}
+
+template<size_t W, typename ComputeBlock>
+void computeBlocks(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices, ComputeBlock computeBlock) {
+	Block<W> block;
+
+	// the remainder is padded instead of taking the scalar path, so that every transform uses the same sine and cosine
+	for (size_t first = 0; first < transforms.size(); first += W) {
+		size_t count = std::min(W, transforms.size() - first);
+
+		loadBlock(transforms, first, count, block);
+		computeBlock(block);
+		storeBlock(block, first, count, modelMatrices, normalMatrices);
+	}
+}
+
+#endif
+
+}
+
+void TransformArrays::clear() {
+	translationX.clear();
+	translationY.clear();
+	translationZ.clear();
+	rotationX.clear();
+	rotationY.clear();
+	rotationZ.clear();
+	scaleX.clear();
+	scaleY.clear();
+	scaleZ.clear();
+}
+
+void TransformArrays::push(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale) {
+	translationX.push_back(translation.x);
+	translationY.push_back(translation.y);
+	translationZ.push_back(translation.z);
+	rotationX.push_back(rotation.x);
+	rotationY.push_back(rotation.y);
+	rotationZ.push_back(rotation.z);
+	scaleX.push_back(scale.x);
+	scaleY.push_back(scale.y);
+	scaleZ.push_back(scale.z);
+}
+
+void TransformKernel::computeMatrices(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices) {
+	computeMatrices(transforms, modelMatrices, normalMatrices, getBestPath());
+}
+
+void TransformKernel::computeMatrices(const TransformArrays& transforms, glm::mat4* modelMatrices, glm::mat3* normalMatrices, Path path) {
+	switch (path) {
+#if TRANSFORM_X86
+	case Path::AVX2:
+		computeBlocks<8>(transforms, modelMatrices, normalMatrices, computeBlockAVX2);
+		break;
+	case Path::SSE:
+		computeBlocks<4>(transforms, modelMatrices, normalMatrices, computeBlockSSE);
+		break;
+#endif
+	default:
+		computeScalar(transforms, modelMatrices, normalMatrices);
+		break;
+	}
+}
+
+bool TransformKernel::isSupported(Path path) {
+	switch (path) {
+#if TRANSFORM_X86
+	case Path::AVX2:
+		return Common::cpuSupportsAVX2();
+	case Path::SSE:
+		return true;
+#endif
+	case Path::Scalar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+TransformKernel::Path TransformKernel::getBestPath() {
+	static const Path best = isSupported(Path::AVX2) ? Path::AVX2 : isSupported(Path::SSE) ? Path::SSE : Path::Scalar;
+	return best;
+}
+
+const char* TransformKernel::getPathName(Path path) {
+	switch (path) {
+	case Path::AVX2:
+		return "AVX2";
+	case Path::SSE:
+		return "SSE";
+	default:
+		return "Scalar";
+	}
+}
+
+}
@@ -0,0 +1,141 @@
+#include "renderer/VertexWelder.hpp"
+
+#include <cstring>
+
+namespace stl {
+
+static_assert(sizeof(Model::Vertex) == 11 * sizeof(float), "Vertex must be tightly packed to be compared bitwise");
+
+VertexWelder::VertexWelder(std::vector<Model::Vertex>& vertices, size_t expectedCount, float epsilon)
+	: m_Vertices{ vertices }, m_Base{ static_cast<uint32_t>(vertices.size()) }, m_InvEpsilon{ epsilon > 0.0f ? 1.0f / epsilon : 0.0f }, m_EpsilonSquared{ epsilon * epsilon } {
+	size_t capacity = 16;
+
+	while (capacity < expectedCount) {
+		capacity <<= 1;
+	}
+
+	m_Slots.assign(capacity, EMPTY);
+	m_Tags.resize(capacity);
+	m_Mask = capacity - 1;
+}
+
+uint32_t VertexWelder::weld(const Model::Vertex& vertex) {
+	Key key = makeKey(vertex);
+	uint64_t hash = hashKey(key);
+
+	if (m_InvEpsilon > 0.0f) {
+		// the cells are as large as epsilon, every position within it lies in one of the 27 cells around the vertex
+		auto isNear = [&](uint32_t local) {
+			glm::vec3 offset = m_Vertices[m_Base + local].position - vertex.position;
+			return glm::dot(offset, offset) <= m_EpsilonSquared;
+		};
+
+		for (int z = -1; z <= 1; z++) {
+			for (int y = -1; y <= 1; y++) {
+				for (int x = -1; x <= 1; x++) {
+					bool center = x == 0 && y == 0 && z == 0;
+					Key neighbour = center ? key : makeKey(vertex, glm::vec3(x, y, z));
+					uint32_t local = find(neighbour, center ? hash : hashKey(neighbour), isNear);
+
+					if (local != EMPTY) return m_Base + local;
+				}
+			}
+		}
+	} else {
+		uint32_t local = find(key, hash, [](uint32_t) { return true; });
+
+		if (local != EMPTY) return m_Base + local;
+	}
+
+	uint32_t local = static_cast<uint32_t>(m_Keys.size());
+
+	insert(local, hash);
+	m_Keys.push_back(key);
+	m_Vertices.push_back(vertex);
+
+	// keep the load factor at or below 0.5
+	if (m_Keys.size() * 2 > m_Slots.size()) {
+		grow();
+	}
+
+	return m_Base + local;
+}
+
+template<typename F>
+uint32_t VertexWelder::find(const Key& key, uint64_t hash, F&& accept) const {
+	uint32_t tag = static_cast<uint32_t>(hash >> 32);
+	size_t slot = hash & m_Mask;
+
+	// vertices of a cell that are too far apart share a key, so the whole probe sequence is searched
+	while (m_Slots[slot] != EMPTY) {
+		uint32_t local = m_Slots[slot];
+
+		if (m_Tags[slot] == tag && memcmp(&m_Keys[local], &key, sizeof(Key)) == 0 && accept(local)) {
+			return local;
+		}
+
+		slot = (slot + 1) & m_Mask;
+	}
+
+	return EMPTY;
+}
+
+VertexWelder::Key VertexWelder::makeKey(const Model::Vertex& vertex, const glm::vec3& cellOffset) const {
+	Model::Vertex canonical = vertex;
+
+	if (m_InvEpsilon > 0.0f) {
+		canonical.position = glm::floor(vertex.position * m_InvEpsilon) + cellOffset;
+	}
+
+	float values[sizeof(Model::Vertex) / sizeof(float)];
+	memcpy(values, &canonical, sizeof(Model::Vertex));
+
+	// adding zero maps -0.0 to +0.0 so both compare equal bitwise, like they do with operator==
+	for (float& value : values) {
+		value += 0.0f;
+	}
+
+	Key key;
+	memcpy(key.words, values, sizeof(Key));
+
+	return key;
+}
+
+uint64_t VertexWelder::hashKey(const Key& key) {
+	uint64_t hash = 0x9e3779b97f4a7c15ull;
+
+	for (uint32_t word : key.words) {
+		hash = (hash ^ word) * 0xbf58476d1ce4e5b9ull;
+	}
+
+	hash ^= hash >> 31;
+	hash *= 0x94d049bb133111ebull;
+	hash ^= hash >> 29;
+
+	return hash;
+}
+
+void VertexWelder::insert(uint32_t local, uint64_t hash) {
+	size_t slot = hash & m_Mask;
+
+	while (m_Slots[slot] != EMPTY) {
+		slot = (slot + 1) & m_Mask;
+	}
+
+	m_Slots[slot] = local;
+	m_Tags[slot] = static_cast<uint32_t>(hash >> 32);
+}
+
+void VertexWelder::grow() {
+	size_t capacity = m_Slots.size() * 2;
+
+	m_Slots.assign(capacity, EMPTY);
+	m_Tags.resize(capacity);
+	m_Mask = capacity - 1;
+
+	for (uint32_t local = 0; local < m_Keys.size(); local++) {
+		insert(local, hashKey(m_Keys[local]));
+	}
+}
+
+}
@@ -0,0 +1,45 @@
+#include "renderer/wrapper/MemoryBackend.hpp"
+
+#include <algorithm>
+
+namespace stl {
+
+VulkanMemoryBackend::VulkanMemoryBackend(VkDevice device, VkPhysicalDevice physicalDevice)
+	: m_Device{ device } {
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_MemoryProperties);
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	m_NonCoherentAtomSize = std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+}
+
+VkResult VulkanMemoryBackend::allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory* memory) {
+	VkMemoryAllocateInfo allocInfo = {};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+	return vkAllocateMemory(m_Device, &allocInfo, nullptr, memory);
+}
+
+void VulkanMemoryBackend::freeMemory(VkDeviceMemory memory) {
+	vkFreeMemory(m_Device, memory, nullptr);
+}
+
+VkResult VulkanMemoryBackend::mapMemory(VkDeviceMemory memory, void** mapped) {
+	return vkMapMemory(m_Device, memory, 0, VK_WHOLE_SIZE, 0, mapped);
+}
+
+void VulkanMemoryBackend::unmapMemory(VkDeviceMemory memory) {
+	vkUnmapMemory(m_Device, memory);
+}
+
+VkResult VulkanMemoryBackend::flushMemory(const VkMappedMemoryRange& range) {
+	return vkFlushMappedMemoryRanges(m_Device, 1, &range);
+}
+
+VkResult VulkanMemoryBackend::invalidateMemory(const VkMappedMemoryRange& range) {
+	return vkInvalidateMappedMemoryRanges(m_Device, 1, &range);
+}
+
+}
@@ -0,0 +1,114 @@
+#include "Test.hpp"
+
+#include "Core/BlockSuballocator.hpp"
+
+using namespace stl;
+
+namespace {
+
+void testBestFit() {
+	BlockSuballocator allocator{ 1000 };
+
+	// leave free ranges of 100, 50 and 300 (+ the rest) between used ones
+	uint64_t a = *allocator.allocate(100);
+	uint64_t b = *allocator.allocate(10);
+	uint64_t c = *allocator.allocate(50);
+	uint64_t d = *allocator.allocate(10);
+	uint64_t e = *allocator.allocate(300);
+	allocator.allocate(10);
+
+	allocator.free(a, 100);
+	allocator.free(c, 50);
+	allocator.free(e, 300);
+
+	// the smallest range that fits is picked, not the first one
+	CHECK(allocator.allocate(40) == c);
+	CHECK(allocator.allocate(90) == a);
+	CHECK(allocator.allocate(200) == e);
+
+	CHECK(b == 100);
+	CHECK(d == 160);
+}
+
+void testExactFitAndExhaustion() {
+	BlockSuballocator allocator{ 256 };
+
+	CHECK(allocator.allocate(256) == 0u);
+	CHECK(allocator.getFreeSize() == 0);
+	CHECK(allocator.getFreeRangeCount() == 0);
+	CHECK(!allocator.allocate(1));
+
+	allocator.free(0, 256);
+
+	CHECK(allocator.isEmpty());
+	CHECK(!allocator.allocate(0));
+	CHECK(!allocator.allocate(257));
+}
+
+void testCoalescing() {
+	BlockSuballocator allocator{ 400 };
+
+	uint64_t a = *allocator.allocate(100);
+	uint64_t b = *allocator.allocate(100);
+	uint64_t c = *allocator.allocate(100);
+	uint64_t d = *allocator.allocate(100);
+
+	allocator.free(a, 100);
+	allocator.free(c, 100);
+	CHECK(allocator.getFreeRangeCount() == 2);
+
+	// merges with the preceding and the following range at once
+	allocator.free(b, 100);
+	CHECK(allocator.getFreeRangeCount() == 1);
+	CHECK(allocator.getLargestFreeRange() == 300);
+
+	// merges with the preceding range only
+	allocator.free(d, 100);
+	CHECK(allocator.getFreeRangeCount() == 1);
+	CHECK(allocator.getLargestFreeRange() == 400);
+	CHECK(allocator.isEmpty());
+
+	// merges with the following range only
+	uint64_t e = *allocator.allocate(150);
+	allocator.free(e, 150);
+	CHECK(allocator.getFreeRangeCount() == 1);
+	CHECK(allocator.allocate(400) == 0u);
+}
+
+void testAlignment() {
+	BlockSuballocator allocator{ 1024 };
+
+	CHECK(allocator.allocate(10) == 0u);
+
+	// the padding in front of an aligned allocation stays free
+	CHECK(allocator.allocate(100, 256) == 256u);
+	CHECK(allocator.getFreeRangeCount() == 2);
+	CHECK(allocator.allocate(200) == 10u);
+
+	// a free range large enough but without an aligned offset inside it is skipped
+	BlockSuballocator skipping{ 1024 };
+	uint64_t a = *skipping.allocate(1);
+	uint64_t b = *skipping.allocate(100);
+	skipping.allocate(1);
+	skipping.free(b, 100);
+
+	CHECK(a == 0);
+	CHECK(skipping.allocate(64, 64) == 128u);
+
+	// non power of two alignments work as well
+	BlockSuballocator odd{ 100 };
+	odd.allocate(1);
+	CHECK(odd.allocate(10, 3) == 3u);
+	CHECK(odd.getUsedSize() == 11);
+}
+
+}
+
+int main() {
+	testBestFit();
+	testExactFitAndExhaustion();
+	testCoalescing();
+	testAlignment();
+
+	return test::finish("BlockSuballocatorTests");
+}
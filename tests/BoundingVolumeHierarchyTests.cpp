@@ -0,0 +1,198 @@
+#include "Test.hpp"
+
+#include "renderer/BoundingVolumeHierarchy.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr float MISS = std::numeric_limits<float>::infinity();
+
+std::vector<Aabb> createItems(size_t count, std::mt19937& rng) {
+	// the world grows with the item count so that the density stays the same
+	float worldSize = std::cbrt(static_cast<float>(count)) * 4.0f;
+
+	std::uniform_real_distribution<float> position{ -worldSize, worldSize };
+	std::uniform_real_distribution<float> extent{ 0.1f, 1.0f };
+
+	std::vector<Aabb> items(count);
+
+	for (Aabb& item : items) {
+		glm::vec3 center{ position(rng), position(rng), position(rng) };
+		glm::vec3 halfSize{ extent(rng), extent(rng), extent(rng) };
+		item = Aabb{ center - halfSize, center + halfSize };
+	}
+
+	return items;
+}
+
+std::vector<uint32_t> sorted(std::vector<uint32_t> items) {
+	std::sort(items.begin(), items.end());
+	return items;
+}
+
+// Entry distance of the ray into the box in units of the direction, the same slab test the tree uses
+float intersectBruteForce(const Aabb& item, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+	glm::vec3 inverseDirection = 1.0f / direction;
+
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+
+	for (int axis = 0; axis < 3; axis++) {
+		float t0 = (item.min[axis] - origin[axis]) * inverseDirection[axis];
+		float t1 = (item.max[axis] - origin[axis]) * inverseDirection[axis];
+
+		if (t0 > t1) std::swap(t0, t1);
+
+		tMin = t0 > tMin ? t0 : tMin;
+		tMax = t1 < tMax ? t1 : tMax;
+
+		if (tMin > tMax) return MISS;
+	}
+
+	return tMin;
+}
+
+void checkQueries(const BoundingVolumeHierarchy& bvh, const std::vector<Aabb>& items, std::mt19937& rng) {
+	float worldSize = std::cbrt(static_cast<float>(std::max<size_t>(items.size(), 1))) * 4.0f;
+	std::uniform_real_distribution<float> position{ -worldSize, worldSize };
+	std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+
+	// frustum
+	glm::mat4 projection = glm::perspective(glm::radians(50.0f), 1.5f, 0.1f, worldSize);
+	glm::mat4 view = glm::lookAt(glm::vec3{ 0.0f, 0.0f, -worldSize }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+	Frustum frustum{ projection * view };
+
+	std::vector<uint32_t> result;
+	std::vector<uint32_t> expected;
+
+	bvh.queryFrustum(frustum, result);
+
+	for (uint32_t i = 0; i < items.size(); i++) {
+		if (frustum.intersectsBox(items[i].min, items[i].max)) expected.push_back(i);
+	}
+
+	CHECK(sorted(result) == expected);
+
+	// spheres, from ones that touch a few items to ones that contain most of them
+	for (float radius : { 0.0f, 1.0f, worldSize * 0.25f, worldSize * 2.0f }) {
+		glm::vec3 center{ position(rng), position(rng), position(rng) };
+
+		result.clear();
+		expected.clear();
+
+		bvh.querySphere(center, radius, result);
+
+		for (uint32_t i = 0; i < items.size(); i++) {
+			glm::vec3 offset = glm::clamp(center, items[i].min, items[i].max) - center;
+
+			if (glm::dot(offset, offset) <= radius * radius) expected.push_back(i);
+		}
+
+		CHECK(sorted(result) == expected);
+	}
+
+	// rays from outside and inside the items, some of them axis aligned, with and without a distance limit
+	for (int ray = 0; ray < 50; ray++) {
+		glm::vec3 origin{ position(rng), position(rng), position(rng) };
+		glm::vec3 direction{ unit(rng), unit(rng), unit(rng) };
+
+		if (ray % 5 == 0) {
+			direction = glm::vec3{ 0.0f };
+			direction[ray % 3] = ray % 2 ? 2.0f : -0.5f;
+		} else if (ray % 2 == 1 && !items.empty()) {
+			// aimed at an item, so most rays hit something
+			const Aabb& target = items[rng() % items.size()];
+			direction = (target.min + target.max) * 0.5f - origin;
+		}
+
+		for (float maxDistance : { MISS, worldSize * 0.1f }) {
+			float closest = MISS;
+
+			for (const Aabb& item : items) {
+				closest = std::min(closest, intersectBruteForce(item, origin, direction, maxDistance));
+			}
+
+			auto hit = bvh.raycast(origin, direction, maxDistance);
+
+			CHECK(hit.has_value() == (closest != MISS));
+
+			if (hit && closest != MISS) {
+				CHECK(hit->distance == closest);
+				CHECK(intersectBruteForce(items[hit->item], origin, direction, maxDistance) == closest);
+			}
+		}
+	}
+}
+
+void testQueriesMatchBruteForce() {
+	std::mt19937 rng{ 11 };
+
+	for (size_t count : { 0, 1, 5, 17, 1000, 20000 }) {
+		std::vector<Aabb> items = createItems(count, rng);
+
+		BoundingVolumeHierarchy bvh;
+		bvh.build(items);
+
+		CHECK(bvh.getItemCount() == count);
+		checkQueries(bvh, items, rng);
+
+		// move a tenth of the items and refit instead of rebuilding
+		std::uniform_real_distribution<float> offset{ -3.0f, 3.0f };
+
+		for (size_t moved = 0; moved < count / 10 + 1 && count > 0; moved++) {
+			uint32_t item = static_cast<uint32_t>(rng() % count);
+			glm::vec3 translation{ offset(rng), offset(rng), offset(rng) };
+
+			items[item].min += translation;
+			items[item].max += translation;
+			bvh.update(item, items[item]);
+		}
+
+		bvh.refit();
+		checkQueries(bvh, items, rng);
+	}
+}
+
+void testDegenerateItems() {
+	std::mt19937 rng{ 5 };
+
+	// identical boxes cannot be split by position at all
+	std::vector<Aabb> items(1000, Aabb{ glm::vec3{ 0.0f }, glm::vec3{ 1.0f } });
+
+	BoundingVolumeHierarchy bvh;
+	bvh.build(items);
+	checkQueries(bvh, items, rng);
+
+	// a ray that starts inside a box hits it at distance 0
+	auto hit = bvh.raycast(glm::vec3{ 0.5f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, MISS);
+	CHECK(hit.has_value() && hit->distance == 0.0f);
+
+	// a ray pointing away from every box misses
+	CHECK(!bvh.raycast(glm::vec3{ 2.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, MISS));
+
+	// a cleared tree finds nothing
+	bvh.clear();
+
+	std::vector<uint32_t> result;
+	bvh.querySphere(glm::vec3{ 0.0f }, 10.0f, result);
+
+	CHECK(result.empty());
+	CHECK(!bvh.raycast(glm::vec3{ -1.0f }, glm::vec3{ 1.0f }, MISS));
+}
+
+}
+
+int main() {
+	testQueriesMatchBruteForce();
+	testDegenerateItems();
+
+	return test::finish("BoundingVolumeHierarchyTests");
+}
@@ -0,0 +1,122 @@
+#include "Test.hpp"
+
+#include "renderer/CullingKernel.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr CullingKernel::Path PATHS[] = { CullingKernel::Path::SSE, CullingKernel::Path::AVX2 };
+
+Frustum createFrustum() {
+	glm::mat4 projection = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3{ 3.0f, 2.0f, -5.0f }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f });
+
+	return Frustum{ projection * view };
+}
+
+SphereArrays createSpheres(size_t count, uint32_t seed) {
+	std::mt19937 rng{ seed };
+	std::uniform_real_distribution<float> position{ -120.0f, 120.0f };
+	std::uniform_real_distribution<float> radius{ 0.0f, 5.0f };
+
+	SphereArrays spheres;
+
+	for (size_t i = 0; i < count; i++) {
+		spheres.push({ position(rng), position(rng), position(rng) }, radius(rng));
+	}
+
+	return spheres;
+}
+
+// Every vector path has to agree with the scalar path on every sphere, including the ones in the scalar tail
+void testPathsMatchScalar() {
+	Frustum frustum = createFrustum();
+
+	for (size_t count : { 0, 1, 3, 4, 5, 7, 8, 9, 15, 17, 1000, 100003 }) {
+		SphereArrays spheres = createSpheres(count, static_cast<uint32_t>(count));
+
+		std::vector<uint8_t> reference(count);
+		uint32_t referenceCount = CullingKernel::cullSpheres(frustum, spheres, reference.data(), CullingKernel::Path::Scalar);
+
+		uint32_t visible = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			bool expected = frustum.intersectsSphere({ spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i] }, spheres.radius[i]);
+			CHECK(reference[i] == (expected ? 1 : 0));
+			visible += reference[i];
+		}
+
+		CHECK(referenceCount == visible);
+
+		for (CullingKernel::Path path : PATHS) {
+			if (!CullingKernel::isSupported(path)) continue;
+
+			// filled with garbage, every entry has to be written
+			std::vector<uint8_t> visibility(count, 0xcd);
+
+			CHECK(CullingKernel::cullSpheres(frustum, spheres, visibility.data(), path) == referenceCount);
+			CHECK(visibility == reference);
+		}
+	}
+}
+
+// Spheres touching a plane from outside are still visible, ones just beyond it are not
+void testTouchingPlanes() {
+	Frustum frustum = createFrustum();
+	const auto& planes = frustum.getPlanes();
+
+	SphereArrays spheres;
+
+	for (const glm::vec4& plane : planes) {
+		glm::vec3 normal{ plane };
+		float length = glm::length(normal);
+
+		// a point on the plane, moved outwards by the radius
+		glm::vec3 onPlane = -normal * (plane.w / (length * length));
+
+		for (float radius : { 0.5f, 1.0f, 2.0f }) {
+			spheres.push(onPlane - normal / length * (radius * 0.5f), radius);
+			spheres.push(onPlane - normal / length * (radius * 2.0f), radius);
+		}
+	}
+
+	std::vector<uint8_t> reference(spheres.size());
+	CullingKernel::cullSpheres(frustum, spheres, reference.data(), CullingKernel::Path::Scalar);
+
+	for (CullingKernel::Path path : PATHS) {
+		if (!CullingKernel::isSupported(path)) continue;
+
+		std::vector<uint8_t> visibility(spheres.size());
+		CullingKernel::cullSpheres(frustum, spheres, visibility.data(), path);
+
+		CHECK(visibility == reference);
+	}
+
+	// the ones moved outwards by twice their radius can not reach into the frustum
+	for (size_t i = 1; i < spheres.size(); i += 2) {
+		CHECK(reference[i] == 0);
+	}
+}
+
+void testBestPath() {
+	CHECK(CullingKernel::isSupported(CullingKernel::Path::Scalar));
+	CHECK(CullingKernel::isSupported(CullingKernel::getBestPath()));
+
+	std::cout << "best path: " << CullingKernel::getPathName(CullingKernel::getBestPath()) << std::endl;
+}
+
+}
+
+int main() {
+	testPathsMatchScalar();
+	testTouchingPlanes();
+	testBestPath();
+
+	return test::finish("CullingKernelTests");
+}
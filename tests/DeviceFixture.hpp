@@ -0,0 +1,43 @@
+#pragma once
+
+#include "renderer/wrapper/Window.hpp"
+#include "renderer/wrapper/Device.hpp"
+
+#include <exception>
+#include <iostream>
+#include <memory>
+
+namespace stl::test {
+
+// tests that cannot run without a gpu return this, ctest reports them as skipped
+constexpr int SKIPPED = 77;
+
+// Hidden window and device for tests that need the gpu, a software implementation like lavapipe is enough
+struct DeviceFixture {
+	std::unique_ptr<Window> window;
+	std::unique_ptr<Device> device;
+
+	// Null if there is no display or no vulkan device
+	static std::unique_ptr<DeviceFixture> create() {
+		if (!glfwInit() || !glfwVulkanSupported()) {
+			std::cerr << "No vulkan capable display available" << std::endl;
+			return nullptr;
+		}
+
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+		auto fixture = std::make_unique<DeviceFixture>();
+
+		try {
+			fixture->window = std::make_unique<Window>(64, 64, "Starlight Tests");
+			fixture->device = std::make_unique<Device>(*fixture->window);
+		} catch (const std::exception& e) {
+			std::cerr << "Failed to create device: " << e.what() << std::endl;
+			return nullptr;
+		}
+
+		return fixture;
+	}
+};
+
+}
@@ -0,0 +1,132 @@
+#include "Test.hpp"
+#include "DeviceFixture.hpp"
+
+#include "renderer/FrameAllocator.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr VkDeviceSize FRAME_SIZE = 64 * 1024;
+constexpr VkDeviceSize BINDING_RANGE = 16 * 1024;
+constexpr int ALLOCATION_COUNT = 12;
+
+// Fills the binding range several times over, which no longer fits into the frame's initial buffer
+std::vector<FrameAllocation> allocateRanges(Device& device, FrameAllocator& allocator) {
+	VkDeviceSize alignment = std::max<VkDeviceSize>(device.p_Properties.limits.minStorageBufferOffsetAlignment, 1);
+	std::vector<FrameAllocation> allocations;
+
+	for (int i = 0; i < ALLOCATION_COUNT; i++) {
+		FrameAllocation allocation = allocator.allocateStorage(allocator.getBindingRange());
+
+		CHECK(allocation.data != nullptr);
+		CHECK(allocation.buffer != VK_NULL_HANDLE);
+		CHECK(allocation.storageSet != VK_NULL_HANDLE);
+		CHECK(allocation.offset % alignment == 0);
+		CHECK(allocation.size == allocator.getBindingRange());
+
+		memset(allocation.data, i, allocation.size);
+		allocations.push_back(allocation);
+	}
+
+	return allocations;
+}
+
+size_t countBuffers(const std::vector<FrameAllocation>& allocations) {
+	std::set<VkBuffer> buffers;
+
+	for (const FrameAllocation& allocation : allocations) {
+		buffers.insert(allocation.buffer);
+	}
+
+	return buffers.size();
+}
+
+void testGrowsPastFrameSize(Device& device) {
+	FrameAllocator allocator{ device, FRAME_SIZE, BINDING_RANGE };
+	VkDeviceSize range = allocator.getBindingRange();
+
+	CHECK(range <= BINDING_RANGE);
+
+	allocator.beginFrame(0);
+	VkDeviceSize initialSize = allocator.getFrameSize();
+
+	std::vector<FrameAllocation> allocations = allocateRanges(device, allocator);
+
+	CHECK(countBuffers(allocations) > 1);
+	CHECK(allocator.getUsedBytes() >= ALLOCATION_COUNT * range);
+	CHECK(allocator.getFrameSize() > initialSize);
+
+	// the outgrown buffers stay mapped until the frame comes around again
+	for (int i = 0; i < ALLOCATION_COUNT; i++) {
+		const auto* bytes = static_cast<const unsigned char*>(allocations[i].data);
+
+		CHECK(bytes[0] == i && bytes[allocations[i].size - 1] == i);
+	}
+
+	allocator.flush();
+
+	// the other frame starts out with its own buffer
+	allocator.beginFrame(1);
+	CHECK(allocator.getFrameSize() == initialSize);
+	CHECK(allocator.getUsedBytes() == 0);
+
+	// the frame starts with a buffer that fits all of last time's allocations
+	allocator.beginFrame(0);
+	VkDeviceSize grownSize = allocator.getFrameSize();
+
+	CHECK(grownSize >= ALLOCATION_COUNT * range);
+
+	allocations = allocateRanges(device, allocator);
+
+	CHECK(countBuffers(allocations) == 1);
+	CHECK(allocator.getFrameSize() == grownSize);
+
+	allocator.flush();
+}
+
+void testLargeAllocations(Device& device) {
+	FrameAllocator allocator{ device, FRAME_SIZE, BINDING_RANGE };
+	allocator.beginFrame(0);
+
+	// data that is not bound as storage can be larger than the binding range and than twice the frame size
+	FrameAllocation allocation = allocator.allocate(10 * FRAME_SIZE, 16);
+
+	CHECK(allocation.offset == 0);
+	CHECK(allocator.getFrameSize() >= 10 * FRAME_SIZE);
+
+	memset(allocation.data, 1, allocation.size);
+	allocator.flush();
+
+	// storage allocations have to be split by the caller
+	bool thrown = false;
+
+	try {
+		allocator.allocateStorage(allocator.getBindingRange() + 1);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	CHECK(thrown);
+}
+
+}
+
+int main() {
+	auto fixture = test::DeviceFixture::create();
+
+	if (!fixture) {
+		return test::SKIPPED;
+	}
+
+	testGrowsPastFrameSize(*fixture->device);
+	testLargeAllocations(*fixture->device);
+
+	return test::finish("FrameAllocatorTests");
+}
@@ -0,0 +1,131 @@
+#include "Test.hpp"
+
+#include "renderer/FrustumCuller.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+// Lights of the scene whose billboard sphere intersects the frustum, tested one by one
+std::vector<GameObject::id_t> cullBruteForce(const Camera& camera, Scene& scene) {
+	Frustum frustum{ camera.getProjection() * camera.getView() };
+	std::vector<GameObject::id_t> visible;
+
+	for (GameObject::id_t id : scene.getPointLights().getIds()) {
+		const TransformComponent& transform = scene.getTransforms().get(id);
+
+		if (frustum.intersectsSphere(transform.getWorldPosition(), transform.getScale().x)) {
+			visible.push_back(id);
+		}
+	}
+
+	std::sort(visible.begin(), visible.end());
+	return visible;
+}
+
+std::vector<GameObject::id_t> sorted(std::vector<GameObject::id_t> ids) {
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+// Moves, adds, removes and reparents objects between frames and compares the incremental result with brute force
+void testMatchesBruteForce() {
+	std::mt19937 rng{ 7 };
+	std::uniform_real_distribution<float> position{ -60.0f, 60.0f };
+	std::uniform_int_distribution<int> coin{ 0, 9 };
+
+	Scene scene;
+	std::vector<GameObject::id_t> ids;
+
+	for (int i = 0; i < 2000; i++) {
+		GameObject light = scene.createPointLight(1.0f, 0.5f);
+		light.getTransform().setTranslation({ position(rng), position(rng), position(rng) });
+		ids.push_back(light.getId());
+	}
+
+	Camera camera{};
+	camera.setViewTarget({ 0.0f, 0.0f, -40.0f }, { 0.0f, 0.0f, 0.0f });
+	camera.setPerspectiveProjection(glm::radians(50.0f), 1.5f, 0.1f, 80.0f);
+
+	FrustumCuller culler{};
+
+	for (int frame = 0; frame < 60; frame++) {
+		for (int i = 0; i < 50; i++) {
+			GameObject::id_t id = ids[rng() % ids.size()];
+			TransformComponent& transform = scene.getTransforms().get(id);
+
+			transform.setTranslation({ position(rng), position(rng), position(rng) });
+
+			// reading the matrices right away must not hide the change from the culler
+			if (coin(rng) == 0) transform.getModelMatrix();
+		}
+
+		if (frame % 10 == 3) {
+			scene.destroyGameObject(ids.back());
+			ids.pop_back();
+
+			GameObject light = scene.createPointLight(1.0f, 0.5f);
+			light.getTransform().setTranslation({ position(rng), position(rng), position(rng) });
+			ids.push_back(light.getId());
+		}
+
+		// children only move with their parent
+		if (frame % 10 == 5) {
+			scene.setParent(ids[frame], ids[frame + 1]);
+			scene.getTransforms().get(ids[frame + 1]).setTranslation({ position(rng), position(rng), position(rng) });
+		}
+
+		scene.updateTransforms();
+
+		// a skipped frame has to be caught up on
+		if (frame % 10 == 7) {
+			scene.getTransforms().get(ids[0]).setTranslation({ position(rng), position(rng), position(rng) });
+			scene.updateTransforms();
+		}
+
+		culler.cull(camera, scene);
+
+		CHECK(sorted(culler.getVisibleLights()) == cullBruteForce(camera, scene));
+		CHECK(culler.getVisibleObjects().empty());
+	}
+}
+
+// Transforms that did not change are not reported again
+void testUpdatedTransforms() {
+	Scene scene;
+
+	GameObject parent = scene.createGameObject();
+	GameObject child = scene.createGameObject();
+	GameObject other = scene.createGameObject();
+
+	child.setParent(parent);
+	scene.updateTransforms();
+
+	parent.getTransform().setTranslation({ 1.0f, 0.0f, 0.0f });
+	CHECK(scene.updateTransforms() == 2);
+	CHECK(sorted(scene.getUpdatedTransforms()) == sorted({ parent.getId(), child.getId() }));
+	CHECK(child.getTransform().getWorldPosition().x == 1.0f);
+
+	other.getTransform().setScale(glm::vec3{ 2.0f });
+	other.getTransform().getModelMatrix();
+	CHECK(scene.updateTransforms() == 1);
+	CHECK(scene.getUpdatedTransforms() == std::vector<GameObject::id_t>{ other.getId() });
+
+	uint64_t updateCount = scene.getTransformUpdateCount();
+	CHECK(scene.updateTransforms() == 0);
+	CHECK(scene.getUpdatedTransforms().empty());
+	CHECK(scene.getTransformUpdateCount() == updateCount + 1);
+}
+
+}
+
+int main() {
+	testMatchesBruteForce();
+	testUpdatedTransforms();
+
+	return test::finish("FrustumCullerTests");
+}
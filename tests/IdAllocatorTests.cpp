@@ -0,0 +1,201 @@
+#include "Test.hpp"
+
+#include "Core/IdAllocator.hpp"
+#include "Core/ComponentStore.hpp"
+#include "Scene.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr int THREAD_COUNT = 8;
+
+// Every thread allocates single ids and batches and frees part of them again, so indices are reused while other
+// threads allocate
+void testConcurrentAllocation() {
+	IdAllocator allocator;
+	std::vector<std::vector<IdAllocator::id_t>> threadIds(THREAD_COUNT);
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < THREAD_COUNT; thread++) {
+		threads.emplace_back([&, thread] {
+			std::vector<IdAllocator::id_t>& ids = threadIds[thread];
+
+			for (int i = 0; i < 2000; i++) {
+				if (i % 2) {
+					ids.push_back(allocator.allocate());
+				} else {
+					allocator.allocate(3, ids);
+				}
+
+				if (i % 3 == 0) {
+					allocator.free(ids.back());
+					ids.pop_back();
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	std::vector<IdAllocator::id_t> all;
+
+	for (const auto& ids : threadIds) {
+		all.insert(all.end(), ids.begin(), ids.end());
+	}
+
+	std::vector<uint32_t> indices;
+
+	for (IdAllocator::id_t id : all) {
+		CHECK(allocator.isAlive(id));
+		indices.push_back(IdAllocator::getIndex(id));
+	}
+
+	// no two live ids share an index, which also rules out duplicate ids
+	std::sort(indices.begin(), indices.end());
+	CHECK(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+	CHECK(allocator.getAliveCount() == all.size());
+}
+
+void testStaleIdsAfterReuse() {
+	std::vector<IdAllocator::id_t> ids;
+
+	// up to MIN_FREE_INDICES free indices are held back and new ones are handed out instead
+	IdAllocator fewFree;
+	fewFree.allocate(10, ids);
+	fewFree.free(ids[0]);
+
+	IdAllocator::id_t fresh = fewFree.allocate();
+	CHECK(IdAllocator::getIndex(fresh) == 10);
+	CHECK(IdAllocator::getGeneration(fresh) == 0);
+
+	ids.clear();
+
+	IdAllocator allocator;
+	uint32_t count = static_cast<uint32_t>(IdAllocator::MIN_FREE_INDICES) + 10;
+	allocator.allocate(count, ids);
+
+	ComponentStore<int> store;
+
+	for (IdAllocator::id_t id : ids) {
+		store.add(id, 1);
+	}
+
+	for (IdAllocator::id_t id : ids) {
+		store.remove(id);
+		allocator.free(id);
+	}
+
+	// freeing twice is ignored
+	allocator.free(ids[0]);
+	CHECK(allocator.getAliveCount() == 0);
+
+	// enough indices are free now, they come back first in first out with the next generation
+	for (uint32_t i = 0; i < 5; i++) {
+		IdAllocator::id_t reused = allocator.allocate();
+
+		CHECK(IdAllocator::getIndex(reused) == IdAllocator::getIndex(ids[i]));
+		CHECK(IdAllocator::getGeneration(reused) == IdAllocator::getGeneration(ids[i]) + 1);
+		CHECK(allocator.isAlive(reused));
+		CHECK(!allocator.isAlive(ids[i]));
+
+		store.add(reused, 2);
+
+		CHECK(store.contains(reused));
+		CHECK(!store.contains(ids[i]));
+	}
+}
+
+void testGenerationWraparound() {
+	IdAllocator allocator;
+	std::vector<IdAllocator::id_t> ids;
+
+	// more free indices than are held back, so every allocation reuses the oldest one
+	uint32_t count = static_cast<uint32_t>(IdAllocator::MIN_FREE_INDICES) + 2;
+	allocator.allocate(count, ids);
+
+	IdAllocator::id_t first = ids[0];
+
+	for (IdAllocator::id_t id : ids) {
+		allocator.free(id);
+	}
+
+	std::vector<uint32_t> generations;
+
+	while (generations.size() <= IdAllocator::GENERATION_MASK + 1) {
+		IdAllocator::id_t id = allocator.allocate();
+
+		if (IdAllocator::getIndex(id) == IdAllocator::getIndex(first)) {
+			generations.push_back(IdAllocator::getGeneration(id));
+
+			// the original id only matches again once the generation has wrapped around
+			CHECK(allocator.isAlive(first) == (IdAllocator::getGeneration(id) == 0));
+		}
+
+		CHECK(id != IdAllocator::INVALID_ID);
+		allocator.free(id);
+	}
+
+	for (size_t i = 0; i < generations.size(); i++) {
+		CHECK(generations[i] == ((i + 1) & IdAllocator::GENERATION_MASK));
+	}
+}
+
+void testReservedIds() {
+	Scene scene;
+
+	GameObject::id_t created = scene.reserveId();
+	GameObject::id_t unused = scene.reserveId();
+
+	std::vector<GameObject::id_t> batch;
+	scene.reserveIds(4, batch);
+
+	CHECK(scene.getIdAllocator().getAliveCount() == 6);
+	CHECK(!scene.isAlive(created));
+
+	GameObject object = scene.createGameObject(created);
+	scene.createGameObject(batch[0]);
+
+	CHECK(object.getId() == created);
+	CHECK(scene.isAlive(created));
+	CHECK(scene.getGameObjectCount() == 2);
+
+	// reserved ids that never became objects are released by destroying them
+	scene.destroyGameObject(unused);
+	scene.destroyGameObject(batch[1]);
+
+	CHECK(!scene.getIdAllocator().isAlive(unused));
+	CHECK(!scene.getIdAllocator().isAlive(batch[1]));
+	CHECK(scene.getIdAllocator().getAliveCount() == 4);
+	CHECK(scene.getGameObjectCount() == 2);
+
+	// destroying them again or destroying a created object leaves the other reservations alone
+	scene.destroyGameObject(unused);
+	scene.destroyGameObject(created);
+
+	CHECK(!scene.isAlive(created));
+	CHECK(!object.isValid());
+	CHECK(scene.getIdAllocator().isAlive(batch[2]));
+	CHECK(scene.getIdAllocator().getAliveCount() == 3);
+
+	scene.createGameObject(batch[2]);
+	CHECK(scene.isAlive(batch[2]));
+	CHECK(scene.getGameObjectCount() == 2);
+}
+
+}
+
+int main() {
+	testConcurrentAllocation();
+	testStaleIdsAfterReuse();
+	testGenerationWraparound();
+	testReservedIds();
+
+	return test::finish("IdAllocatorTests");
+}
@@ -0,0 +1,182 @@
+#include "Test.hpp"
+
+#include "renderer/LightClusters.hpp"
+#include "Camera.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr float NEAR = 0.1f;
+constexpr float FAR = 100.0f;
+constexpr float WIDTH = 800.0f;
+constexpr float HEIGHT = 600.0f;
+
+glm::mat4 createProjection() {
+	Camera camera{};
+	camera.setPerspectiveProjection(glm::radians(50.0f), WIDTH / HEIGHT, NEAR, FAR);
+
+	return camera.getProjection();
+}
+
+// view space spheres in front of the camera, some of them reaching past the near and far plane or out of the view
+std::vector<glm::vec4> createLights(uint32_t count, std::mt19937& rng) {
+	std::uniform_real_distribution<float> value{ -1.0f, 1.0f };
+	std::vector<glm::vec4> lights;
+
+	for (uint32_t i = 0; i < count; i++) {
+		lights.push_back({ value(rng) * 40.0f, value(rng) * 25.0f, -50.0f + value(rng) * 52.0f, 0.3f + 2.0f * (value(rng) + 1.0f) });
+	}
+
+	// around the camera, behind it, huge and beside the view
+	lights.push_back({ 0.0f, 0.0f, 0.0f, 1.0f });
+	lights.push_back({ 0.0f, 0.0f, 0.5f, 0.3f });
+	lights.push_back({ 0.0f, 0.0f, -200.0f, 150.0f });
+	lights.push_back({ 100.0f, 0.0f, -10.0f, 1.0f });
+
+	return lights;
+}
+
+// Every light tested against every cluster box with the scalar kernel, the lights of each cluster in ascending order
+std::vector<std::vector<uint32_t>> assignBruteForce(const LightClusters& clusters, const std::vector<glm::vec4>& lights) {
+	const BoxArrays& bounds = clusters.getClusterBounds();
+	std::vector<std::vector<uint32_t>> assignments(clusters.getClusterCount());
+	std::vector<uint32_t> hits(bounds.size());
+
+	for (uint32_t light = 0; light < lights.size(); light++) {
+		const glm::vec4& sphere = lights[light];
+
+		// spheres entirely in front of the near or behind the far plane are not part of any slice
+		if (-sphere.z + sphere.w < NEAR || -sphere.z - sphere.w > FAR) continue;
+
+		uint32_t hitCount = ClusterKernel::intersectSphere(sphere, bounds, 0, clusters.getClusterCount(), hits.data(), ClusterKernel::Path::Scalar);
+
+		for (uint32_t i = 0; i < hitCount; i++) {
+			assignments[hits[i]].push_back(light);
+		}
+	}
+
+	return assignments;
+}
+
+std::vector<uint32_t> getClusterLights(const LightClusters& clusters, uint32_t cluster) {
+	const LightClusters::Cluster& range = clusters.getClusters()[cluster];
+	const auto& indices = clusters.getLightIndices();
+
+	return { indices.begin() + range.offset, indices.begin() + range.offset + range.count };
+}
+
+// The clusters are tested against the planes of their tiles, which is tighter than their boxes. So every assigned light
+// has to overlap the box of its cluster, and all kernel paths, single and multithreaded, have to produce the same
+// sorted lists.
+void testMatchesBruteForce() {
+	std::mt19937 rng{ 5 };
+
+	for (glm::uvec3 gridSize : { glm::uvec3{ 16, 9, 24 }, glm::uvec3{ 7, 5, 3 }, glm::uvec3{ 32, 18, 48 } }) {
+		LightClusters clusters{ gridSize };
+		clusters.setProjection(createProjection());
+
+		std::vector<glm::vec4> lights = createLights(3000, rng);
+		std::vector<std::vector<uint32_t>> reference = assignBruteForce(clusters, lights);
+
+		clusters.build(lights, ClusterKernel::Path::Scalar, false);
+
+		std::vector<std::vector<uint32_t>> expected(clusters.getClusterCount());
+		uint32_t extra = 0;
+
+		for (uint32_t cluster = 0; cluster < clusters.getClusterCount(); cluster++) {
+			expected[cluster] = getClusterLights(clusters, cluster);
+
+			CHECK(std::is_sorted(expected[cluster].begin(), expected[cluster].end()));
+
+			for (uint32_t light : expected[cluster]) {
+				extra += std::binary_search(reference[cluster].begin(), reference[cluster].end(), light) ? 0 : 1;
+			}
+		}
+
+		CHECK(extra == 0);
+
+		for (ClusterKernel::Path path : { ClusterKernel::Path::Scalar, ClusterKernel::Path::SSE, ClusterKernel::Path::AVX2 }) {
+			if (!ClusterKernel::isSupported(path)) continue;
+
+			for (bool multithreaded : { false, true }) {
+				clusters.build(lights, path, multithreaded);
+
+				uint32_t mismatches = 0;
+
+				for (uint32_t cluster = 0; cluster < clusters.getClusterCount(); cluster++) {
+					mismatches += getClusterLights(clusters, cluster) != expected[cluster] ? 1 : 0;
+				}
+
+				CHECK(mismatches == 0);
+			}
+		}
+	}
+}
+
+// A fragment looks up its cluster from the pixel and view depth like SimpleShader.frag, every light reaching it has to
+// be listed there
+void testFragmentsSeeTheirLights() {
+	std::mt19937 rng{ 3 };
+	std::uniform_real_distribution<float> value{ 0.0f, 1.0f };
+
+	glm::mat4 projection = createProjection();
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	LightClusters clusters{};
+	clusters.setProjection(projection);
+
+	std::vector<glm::vec4> lights = createLights(1000, rng);
+	clusters.build(lights);
+
+	glm::uvec3 gridSize = clusters.getGridSize();
+	glm::vec2 sliceScale = clusters.getDepthSliceScale();
+
+	uint32_t misses = 0;
+
+	for (int fragment = 0; fragment < 20000; fragment++) {
+		float pixelX = value(rng) * WIDTH;
+		float pixelY = value(rng) * HEIGHT;
+		float depth = NEAR * std::pow(FAR / NEAR, value(rng));
+
+		// view space position on the ray through the pixel at the given depth
+		glm::vec2 ndc{ pixelX / WIDTH * 2.0f - 1.0f, pixelY / HEIGHT * 2.0f - 1.0f };
+		glm::vec4 nearPoint = inverseProjection * glm::vec4{ ndc.x, ndc.y, 0.0f, 1.0f };
+		glm::vec4 farPoint = inverseProjection * glm::vec4{ ndc.x, ndc.y, 1.0f, 1.0f };
+		glm::vec3 a = glm::vec3{ nearPoint } / nearPoint.w;
+		glm::vec3 b = glm::vec3{ farPoint } / farPoint.w;
+		glm::vec3 position = a + (b - a) * ((-depth - a.z) / (b.z - a.z));
+
+		uint32_t x = std::min(static_cast<uint32_t>(pixelX * gridSize.x / WIDTH), gridSize.x - 1);
+		uint32_t y = std::min(static_cast<uint32_t>(pixelY * gridSize.y / HEIGHT), gridSize.y - 1);
+		float slice = std::clamp(std::floor(std::log(depth) * sliceScale.x + sliceScale.y), 0.0f, static_cast<float>(gridSize.z - 1));
+
+		std::vector<uint32_t> clusterLights = getClusterLights(clusters, clusters.getClusterIndex(x, y, static_cast<uint32_t>(slice)));
+
+		for (uint32_t light = 0; light < lights.size(); light++) {
+			glm::vec3 offset = glm::vec3{ lights[light] } - position;
+
+			if (glm::dot(offset, offset) > lights[light].w * lights[light].w) continue;
+
+			if (!std::binary_search(clusterLights.begin(), clusterLights.end(), light)) {
+				misses++;
+			}
+		}
+	}
+
+	CHECK(misses == 0);
+}
+
+}
+
+int main() {
+	testMatchesBruteForce();
+	testFragmentsSeeTheirLights();
+
+	return test::finish("LightClustersTests");
+}
@@ -0,0 +1,217 @@
+#include "Test.hpp"
+
+#include "renderer/wrapper/MemoryAllocator.hpp"
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr VkDeviceSize HEAP_SIZE = 1ull << 30;
+constexpr VkDeviceSize ATOM_SIZE = 64;
+
+// Hands out host memory instead of device memory and records every call
+class FakeMemoryBackend : public MemoryBackend {
+public:
+	FakeMemoryBackend() {
+		m_Properties.memoryTypeCount = 2;
+		m_Properties.memoryTypes[0] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+		m_Properties.memoryTypes[1] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, 1 };
+
+		m_Properties.memoryHeapCount = 2;
+		m_Properties.memoryHeaps[0] = { HEAP_SIZE, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+		m_Properties.memoryHeaps[1] = { HEAP_SIZE, 0 };
+	}
+
+	const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const override { return m_Properties; }
+	VkDeviceSize getNonCoherentAtomSize() const override { return ATOM_SIZE; }
+
+	VkResult allocateMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory* memory) override {
+		auto bytes = std::make_unique<std::vector<char>>(size);
+		*memory = reinterpret_cast<VkDeviceMemory>(bytes->data());
+		m_Memory[*memory] = std::move(bytes);
+		allocationCount++;
+
+		return VK_SUCCESS;
+	}
+
+	void freeMemory(VkDeviceMemory memory) override { m_Memory.erase(memory); }
+
+	VkResult mapMemory(VkDeviceMemory memory, void** mapped) override {
+		*mapped = m_Memory.at(memory)->data();
+		mappedCount++;
+
+		return VK_SUCCESS;
+	}
+
+	void unmapMemory(VkDeviceMemory memory) override { mappedCount--; }
+
+	VkResult flushMemory(const VkMappedMemoryRange& range) override {
+		flushedRanges.push_back(range);
+		return VK_SUCCESS;
+	}
+
+	VkResult invalidateMemory(const VkMappedMemoryRange& range) override { return VK_SUCCESS; }
+
+	size_t getLiveMemoryCount() const { return m_Memory.size(); }
+
+public:
+	uint32_t allocationCount{ 0 };
+	int mappedCount{ 0 };
+	std::vector<VkMappedMemoryRange> flushedRanges;
+
+private:
+	VkPhysicalDeviceMemoryProperties m_Properties{};
+	std::map<VkDeviceMemory, std::unique_ptr<std::vector<char>>> m_Memory;
+};
+
+VkMemoryRequirements makeRequirements(VkDeviceSize size, VkDeviceSize alignment, uint32_t memoryTypeBits = 0b11) {
+	return VkMemoryRequirements{ size, alignment, memoryTypeBits };
+}
+
+void testSuballocation() {
+	auto backend = std::make_unique<FakeMemoryBackend>();
+	FakeMemoryBackend& fake = *backend;
+	MemoryAllocator allocator{ std::move(backend) };
+
+	Allocation a = allocator.allocate(makeRequirements(1000, 256), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+	Allocation b = allocator.allocate(makeRequirements(1000, 256), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+
+	// both come from one block, without overlapping and on their alignment
+	CHECK(fake.allocationCount == 1);
+	CHECK(a.memory == b.memory);
+	CHECK(a.offset % 256 == 0);
+	CHECK(b.offset % 256 == 0);
+	CHECK(a.offset + a.size <= b.offset || b.offset + b.size <= a.offset);
+	CHECK(a.mapped == nullptr);
+
+	// optimal resources get their own block
+	Allocation c = allocator.allocate(makeRequirements(1000, 256), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, false);
+	CHECK(fake.allocationCount == 2);
+	CHECK(c.memory != a.memory);
+
+	MemoryAllocator::Statistics stats = allocator.getStatistics();
+	CHECK(stats.blockCount == 2);
+	CHECK(stats.allocationCount == 3);
+
+	allocator.free(a);
+	allocator.free(b);
+	allocator.free(c);
+
+	CHECK(a.memory == VK_NULL_HANDLE);
+	CHECK(allocator.getStatistics().usedBytes == 0);
+
+	// empty blocks are kept until trimmed
+	allocator.trim();
+	CHECK(fake.getLiveMemoryCount() == 0);
+}
+
+void testHostVisibleAtoms() {
+	auto backend = std::make_unique<FakeMemoryBackend>();
+	FakeMemoryBackend& fake = *backend;
+	MemoryAllocator allocator{ std::move(backend) };
+
+	Allocation a = allocator.allocate(makeRequirements(10, 4), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, true);
+	Allocation b = allocator.allocate(makeRequirements(10, 4), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, true);
+
+	// mapped allocations are kept on whole atoms, so flushing one never touches the other
+	CHECK(a.offset % ATOM_SIZE == 0);
+	CHECK(b.offset % ATOM_SIZE == 0);
+	CHECK(a.size == ATOM_SIZE);
+	CHECK(a.mapped != nullptr);
+	CHECK(static_cast<char*>(b.mapped) - static_cast<char*>(a.mapped) == static_cast<ptrdiff_t>(b.offset - a.offset));
+	CHECK(fake.mappedCount == 1);
+
+	// flushes are widened to atoms and clamped to the allocation
+	allocator.flush(b, 4, 8);
+	CHECK(fake.flushedRanges.back().offset == b.offset);
+	CHECK(fake.flushedRanges.back().size == ATOM_SIZE);
+
+	allocator.flush(b);
+	CHECK(fake.flushedRanges.back().size == b.size);
+
+	allocator.free(a);
+	allocator.free(b);
+	allocator.trim();
+
+	CHECK(fake.mappedCount == 0);
+}
+
+void testDedicatedAllocations() {
+	auto backend = std::make_unique<FakeMemoryBackend>();
+	FakeMemoryBackend& fake = *backend;
+	MemoryAllocator allocator{ std::move(backend) };
+
+	// more than half a block gets its own memory
+	Allocation large = allocator.allocate(makeRequirements(MemoryAllocator::DEFAULT_BLOCK_SIZE / 2 + 1, 16), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+
+	CHECK(large.dedicated);
+	CHECK(large.offset == 0);
+	CHECK(allocator.getStatistics().dedicatedAllocationCount == 1);
+
+	allocator.free(large);
+
+	CHECK(fake.getLiveMemoryCount() == 0);
+	CHECK(allocator.getStatistics().dedicatedAllocationCount == 0);
+}
+
+void testBlockRelease() {
+	auto backend = std::make_unique<FakeMemoryBackend>();
+	FakeMemoryBackend& fake = *backend;
+	MemoryAllocator allocator{ std::move(backend) };
+
+	// half a block is still suballocated, two of them fill a block
+	VkDeviceSize size = MemoryAllocator::DEFAULT_BLOCK_SIZE / 2;
+
+	Allocation a = allocator.allocate(makeRequirements(size, 1), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+	Allocation b = allocator.allocate(makeRequirements(size, 1), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+	Allocation c = allocator.allocate(makeRequirements(size, 1), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+
+	CHECK(fake.getLiveMemoryCount() == 2);
+	CHECK(c.memory != a.memory);
+
+	// an empty block is released while another one is left, the last one is kept
+	allocator.free(c);
+	CHECK(fake.getLiveMemoryCount() == 1);
+
+	allocator.free(a);
+	allocator.free(b);
+	CHECK(fake.getLiveMemoryCount() == 1);
+
+	// the released slot is reused
+	Allocation d = allocator.allocate(makeRequirements(size, 1), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, true);
+	CHECK(fake.getLiveMemoryCount() == 1);
+
+	allocator.free(d);
+	allocator.trim();
+}
+
+void testMissingMemoryType() {
+	MemoryAllocator allocator{ std::make_unique<FakeMemoryBackend>() };
+
+	bool thrown = false;
+
+	try {
+		allocator.allocate(makeRequirements(16, 16, 0b01), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, true);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+
+	CHECK(thrown);
+}
+
+}
+
+int main() {
+	testSuballocation();
+	testHostVisibleAtoms();
+	testDedicatedAllocations();
+	testBlockRelease();
+	testMissingMemoryType();
+
+	return test::finish("MemoryAllocatorTests");
+}
@@ -0,0 +1,110 @@
+#include "Test.hpp"
+
+#include "renderer/Model.hpp"
+#include "renderer/VertexWelder.hpp"
+
+#include <tiny_obj_loader.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+// enough corners for loadObj to split them into several chunks
+constexpr int POSITION_COUNT = 50000;
+constexpr int TRIANGLE_COUNT = 100000;
+constexpr float STEP = 0.001f;
+
+// Positions on a grid finer than the weld epsilons, so near duplicates chain into each other
+std::filesystem::path writeObj(const std::filesystem::path& directory) {
+	std::filesystem::path path = directory / "welding.obj";
+	std::ofstream file{ path };
+
+	std::mt19937 rng{ 3 };
+	std::uniform_int_distribution<int> cell{ 0, 40 };
+	std::uniform_int_distribution<int> position{ 1, POSITION_COUNT };
+	std::uniform_int_distribution<int> normal{ 1, 4 };
+
+	for (int i = 0; i < POSITION_COUNT; i++) {
+		file << "v " << cell(rng) * STEP << " " << cell(rng) * STEP << " " << cell(rng) * STEP << "\n";
+	}
+
+	file << "vn 0 0 1\nvn 0 1 0\nvn 1 0 0\nvn 0 0 -1\n";
+
+	for (int i = 0; i < TRIANGLE_COUNT; i++) {
+		file << "f";
+
+		for (int corner = 0; corner < 3; corner++) {
+			file << " " << position(rng) << "//" << normal(rng);
+		}
+
+		file << "\n";
+	}
+
+	return path;
+}
+
+// The serial path, every corner welded in file order through one welder
+void weldSerially(const std::string& filepath, float epsilon, std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices) {
+	tinyobj::attrib_t attrib;
+	std::vector<tinyobj::shape_t> shapes;
+	std::vector<tinyobj::material_t> materials;
+	std::string warn, err;
+
+	CHECK(tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str()));
+
+	VertexWelder welder{ vertices, 16, epsilon };
+
+	for (const tinyobj::shape_t& shape : shapes) {
+		for (const tinyobj::index_t& index : shape.mesh.indices) {
+			Model::Vertex vertex{};
+			vertex.position = { attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1], attrib.vertices[3 * index.vertex_index + 2] };
+			vertex.color = { attrib.colors[3 * index.vertex_index + 0], attrib.colors[3 * index.vertex_index + 1], attrib.colors[3 * index.vertex_index + 2] };
+			vertex.normal = { attrib.normals[3 * index.normal_index + 0], attrib.normals[3 * index.normal_index + 1], attrib.normals[3 * index.normal_index + 2] };
+
+			indices.push_back(welder.weld(vertex));
+		}
+	}
+}
+
+void testMatchesSerialWelding(const std::string& filepath, float epsilon) {
+	Model::Data data{};
+	data.weldEpsilon = epsilon;
+	data.loadObj(filepath);
+
+	std::vector<Model::Vertex> vertices;
+	std::vector<uint32_t> indices;
+	weldSerially(filepath, epsilon, vertices, indices);
+
+	CHECK(data.indices.size() == 3 * static_cast<size_t>(TRIANGLE_COUNT));
+	CHECK(data.vertices.size() == vertices.size());
+	CHECK(data.indices == indices);
+	CHECK(data.vertices.size() == vertices.size() && memcmp(data.vertices.data(), vertices.data(), vertices.size() * sizeof(Model::Vertex)) == 0);
+
+	// the epsilons have to actually weld something for the comparison to mean anything
+	CHECK(vertices.size() < data.indices.size());
+}
+
+}
+
+int main() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "StarlightModelDataTests";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	std::string filepath = writeObj(directory).string();
+
+	testMatchesSerialWelding(filepath, 0.0f);
+	testMatchesSerialWelding(filepath, 0.5f * STEP);
+	testMatchesSerialWelding(filepath, 1.5f * STEP);
+
+	std::filesystem::remove_all(directory);
+
+	return test::finish("ModelDataTests");
+}
@@ -0,0 +1,189 @@
+#include "Test.hpp"
+#include "DeviceFixture.hpp"
+
+#include "renderer/ModelLoader.hpp"
+#include "renderer/MeshCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+constexpr int FILE_COUNT = 8;
+constexpr int LOADS_PER_FILE = 8;
+
+std::filesystem::path writeObj(const std::filesystem::path& directory, int index) {
+	std::filesystem::path path = directory / ("model" + std::to_string(index) + ".obj");
+	std::ofstream file{ path };
+
+	// a fan with a different number of triangles per file
+	file << "v 0 0 0\n";
+
+	for (int i = 0; i <= index + 1; i++) {
+		file << "v " << i << " 1 0\n";
+	}
+
+	for (int i = 0; i <= index; i++) {
+		file << "f 1 " << i + 2 << " " << i + 3 << "\n";
+	}
+
+	return path;
+}
+
+// Copies a range of a device local pool buffer back to the host
+template<typename T>
+std::vector<T> readBack(Device& device, VkBuffer source, uint32_t first, uint32_t count) {
+	std::vector<T> values(count);
+
+	if (count == 0) {
+		return values;
+	}
+
+	Buffer staging{ device, sizeof(T), count, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT };
+	CHECK(staging.map() == VK_SUCCESS);
+
+	device.copyBuffer(source, staging.getBuffer(), count * sizeof(T), first * sizeof(T));
+
+	staging.invalidate();
+	memcpy(values.data(), staging.getMappedMemory(), count * sizeof(T));
+
+	return values;
+}
+
+void removeCaches(const std::vector<std::filesystem::path>& paths) {
+	for (const auto& path : paths) {
+		std::filesystem::remove(MeshCache::getCachePath(path.string()));
+	}
+}
+
+void testConcurrentLoads(Device& device) {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "StarlightModelLoaderTests";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	std::vector<std::filesystem::path> paths;
+
+	for (int i = 0; i < FILE_COUNT; i++) {
+		paths.push_back(writeObj(directory, i));
+	}
+
+	GeometryPool pool{ device };
+	ModelLoader loader{ device, pool };
+
+	std::thread::id mainThread = std::this_thread::get_id();
+	std::vector<int> callbackCounts(FILE_COUNT * LOADS_PER_FILE, 0);
+	std::vector<ModelLoader::Handle> handles;
+	bool callbacksOnMainThread = true;
+
+	// all loads are in flight at the same time
+	for (int i = 0; i < FILE_COUNT * LOADS_PER_FILE; i++) {
+		handles.push_back(loader.load(paths[i % FILE_COUNT].string(), [&, i](std::shared_ptr<Model> model) {
+			callbackCounts[i]++;
+			callbacksOnMainThread &= std::this_thread::get_id() == mainThread && model != nullptr;
+		}));
+	}
+
+	ModelLoader::Handle missing = loader.load((directory / "missing.obj").string());
+
+	// parsing happens in the background, callbacks only ever run inside update()
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	for (int count : callbackCounts) {
+		CHECK(count == 0);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (loader.getPendingCount() > 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(30)) {
+		loader.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	CHECK(loader.getPendingCount() == 0);
+	CHECK(callbacksOnMainThread);
+
+	for (int i = 0; i < FILE_COUNT * LOADS_PER_FILE; i++) {
+		CHECK(callbackCounts[i] == 1);
+		CHECK(handles[i].isReady());
+		CHECK(handles[i].get()->getDrawCommand(0).indexCount == 3 * static_cast<uint32_t>(i % FILE_COUNT + 1));
+	}
+
+	CHECK(missing.hasFailed());
+	CHECK(!missing.isReady());
+
+	handles.clear();
+	std::filesystem::remove_all(directory);
+}
+
+void testAssetsMatchSynchronousLoads(Device& device) {
+	std::vector<std::filesystem::path> paths;
+
+	for (const auto& entry : std::filesystem::directory_iterator{ "assets/models" }) {
+		if (entry.path().extension() == ".obj") {
+			paths.push_back(entry.path());
+		}
+	}
+
+	std::sort(paths.begin(), paths.end());
+	CHECK(!paths.empty());
+
+	// both paths parse the source files instead of a cache an earlier run left behind
+	removeCaches(paths);
+
+	GeometryPool pool{ device };
+	ModelLoader loader{ device, pool };
+	std::vector<ModelLoader::Handle> handles;
+
+	for (const auto& path : paths) {
+		handles.push_back(loader.load(path.string()));
+	}
+
+	loader.waitIdle();
+	removeCaches(paths);
+
+	for (size_t i = 0; i < paths.size(); i++) {
+		CHECK(handles[i].isReady());
+
+		if (!handles[i].isReady()) continue;
+
+		const Model& model = *handles[i].get();
+
+		Model::Data data{};
+		data.loadModel(paths[i].string());
+
+		CHECK(model.getVertexCount() == data.vertices.size());
+		CHECK(model.getIndexCount() == data.indices.size());
+		CHECK(readBack<Model::Vertex>(device, pool.getVertexBuffer(), model.getFirstVertex(), model.getVertexCount()) == data.vertices);
+		CHECK(readBack<uint32_t>(device, pool.getIndexBuffer(), model.getFirstIndex(), model.getIndexCount()) == data.indices);
+
+		CHECK(model.getBounds().min == data.bounds.min);
+		CHECK(model.getBounds().max == data.bounds.max);
+		CHECK(model.getBounds().center == data.bounds.center);
+		CHECK(model.getBounds().radius == data.bounds.radius);
+	}
+
+	handles.clear();
+}
+
+}
+
+int main() {
+	auto fixture = test::DeviceFixture::create();
+
+	if (!fixture) {
+		return test::SKIPPED;
+	}
+
+	testConcurrentLoads(*fixture->device);
+	testAssetsMatchSynchronousLoads(*fixture->device);
+
+	return test::finish("ModelLoaderTests");
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+namespace stl::test {
+
+// Minimal checks for the test executables, every test reports its failures and returns them from main
+inline int& failureCount() {
+	static int count = 0;
+	return count;
+}
+
+inline void check(bool condition, const char* expression, const char* file, int line) {
+	if (condition) return;
+
+	std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+	failureCount()++;
+}
+
+inline int finish(const char* name) {
+	if (failureCount() == 0) {
+		std::cout << name << ": all checks passed" << std::endl;
+	} else {
+		std::cerr << name << ": " << failureCount() << " checks failed" << std::endl;
+	}
+
+	return failureCount() == 0 ? 0 : 1;
+}
+
+}
+
+#define CHECK(condition) ::stl::test::check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, tolerance) ::stl::test::check(std::abs((a) - (b)) <= (tolerance), #a " ~= " #b, __FILE__, __LINE__)
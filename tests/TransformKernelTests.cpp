@@ -0,0 +1,138 @@
+#include "Test.hpp"
+
+#include "TransformKernel.hpp"
+#include "GameObject.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+// a few ulps relative to the magnitude of the entry, entries below 1 are compared absolutely
+constexpr float TOLERANCE = 16.0f * FLT_EPSILON;
+
+bool nearlyEqual(float a, float b) {
+	return std::abs(a - b) <= TOLERANCE * std::max(1.0f, std::abs(b));
+}
+
+struct Transforms {
+	TransformArrays arrays;
+	std::vector<TransformComponent> components;
+};
+
+Transforms createTransforms(size_t count, float angleRange, uint32_t seed) {
+	std::mt19937 rng{ seed };
+	std::uniform_real_distribution<float> translation{ -100.0f, 100.0f };
+	std::uniform_real_distribution<float> angle{ -angleRange, angleRange };
+	std::uniform_real_distribution<float> scale{ 0.1f, 4.0f };
+
+	Transforms transforms;
+	transforms.components.resize(count);
+
+	for (size_t i = 0; i < count; i++) {
+		glm::vec3 t{ translation(rng), translation(rng), translation(rng) };
+		glm::vec3 r{ angle(rng), angle(rng), angle(rng) };
+
+		// mirrored objects have a negative scale on one axis
+		glm::vec3 s{ scale(rng) * (i % 2 ? -1.0f : 1.0f), scale(rng), scale(rng) };
+
+		transforms.arrays.push(t, r, s);
+		transforms.components[i].setTranslation(t);
+		transforms.components[i].setRotation(r);
+		transforms.components[i].setScale(s);
+	}
+
+	return transforms;
+}
+
+// Returns the number of transforms whose matrices differ from the component by more than the tolerance
+size_t countMismatches(const Transforms& transforms, TransformKernel::Path path) {
+	size_t count = transforms.arrays.size();
+
+	std::vector<glm::mat4> modelMatrices(count);
+	std::vector<glm::mat3> normalMatrices(count);
+	TransformKernel::computeMatrices(transforms.arrays, modelMatrices.data(), normalMatrices.data(), path);
+
+	size_t mismatches = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		glm::mat4 model = transforms.components[i].modelMatrix();
+		glm::mat3 normal = transforms.components[i].normalMatrix();
+		bool equal = true;
+
+		for (int column = 0; column < 4; column++) {
+			for (int row = 0; row < 4; row++) {
+				equal &= nearlyEqual(modelMatrices[i][column][row], model[column][row]);
+			}
+		}
+
+		for (int column = 0; column < 3; column++) {
+			for (int row = 0; row < 3; row++) {
+				equal &= nearlyEqual(normalMatrices[i][column][row], normal[column][row]);
+			}
+		}
+
+		mismatches += equal ? 0 : 1;
+	}
+
+	return mismatches;
+}
+
+// The scalar path uses the expressions of the component, so it has to match exactly
+void testScalarMatchesComponent() {
+	Transforms transforms = createTransforms(1000, 10.0f, 1);
+
+	std::vector<glm::mat4> modelMatrices(1000);
+	std::vector<glm::mat3> normalMatrices(1000);
+	TransformKernel::computeMatrices(transforms.arrays, modelMatrices.data(), normalMatrices.data(), TransformKernel::Path::Scalar);
+
+	for (size_t i = 0; i < 1000; i++) {
+		CHECK(modelMatrices[i] == transforms.components[i].modelMatrix());
+		CHECK(normalMatrices[i] == transforms.components[i].normalMatrix());
+	}
+}
+
+// The polynomial sine and cosine of the vector paths stay within a few ulps of the scalar path, including the scalar tail
+void testVectorPathsWithinTolerance() {
+	for (float angleRange : { glm::pi<float>(), 50.0f, 1000.0f }) {
+		for (size_t count : { 1, 7, 9, 100003 }) {
+			Transforms transforms = createTransforms(count, angleRange, static_cast<uint32_t>(count));
+
+			for (TransformKernel::Path path : { TransformKernel::Path::SSE, TransformKernel::Path::AVX2 }) {
+				if (!TransformKernel::isSupported(path)) continue;
+
+				size_t mismatches = countMismatches(transforms, path);
+
+				if (mismatches > 0) {
+					std::cerr << TransformKernel::getPathName(path) << ", angles up to " << angleRange << ": " << mismatches
+						<< " of " << count << " transforms out of tolerance" << std::endl;
+				}
+
+				CHECK(mismatches == 0);
+			}
+		}
+	}
+}
+
+void testBestPath() {
+	CHECK(TransformKernel::isSupported(TransformKernel::Path::Scalar));
+	CHECK(TransformKernel::isSupported(TransformKernel::getBestPath()));
+
+	std::cout << "best path: " << TransformKernel::getPathName(TransformKernel::getBestPath()) << std::endl;
+}
+
+}
+
+int main() {
+	testScalarMatchesComponent();
+	testVectorPathsWithinTolerance();
+	testBestPath();
+
+	return test::finish("TransformKernelTests");
+}
@@ -0,0 +1,103 @@
+#include "Test.hpp"
+
+#include "renderer/VertexWelder.hpp"
+
+using namespace stl;
+
+namespace {
+
+Model::Vertex makeVertex(const glm::vec3& position) {
+	Model::Vertex vertex{};
+	vertex.position = position;
+	vertex.normal = { 0.0f, 1.0f, 0.0f };
+
+	return vertex;
+}
+
+void testExactWelding() {
+	std::vector<Model::Vertex> vertices;
+	VertexWelder welder{ vertices, 4 };
+
+	uint32_t a = welder.weld(makeVertex({ 1.0f, 2.0f, 3.0f }));
+	uint32_t b = welder.weld(makeVertex({ 1.0f, 2.0f, 3.0f }));
+	uint32_t c = welder.weld(makeVertex({ 1.0f, 2.0f, 3.00001f }));
+
+	CHECK(a == b);
+	CHECK(a != c);
+	CHECK(vertices.size() == 2);
+
+	// -0.0 and +0.0 compare equal
+	uint32_t d = welder.weld(makeVertex({ 0.0f, 0.0f, 0.0f }));
+	uint32_t e = welder.weld(makeVertex({ -0.0f, 0.0f, 0.0f }));
+
+	CHECK(d == e);
+}
+
+void testWeldingAcrossCells() {
+	std::vector<Model::Vertex> vertices;
+	VertexWelder welder{ vertices, 4, 0.01f };
+
+	// both lie within epsilon of each other, but on different sides of a cell boundary
+	uint32_t a = welder.weld(makeVertex({ 0.0099999f, 0.5f, 0.5f }));
+	uint32_t b = welder.weld(makeVertex({ 0.0100001f, 0.5f, 0.5f }));
+
+	CHECK(a == b);
+	CHECK(vertices.size() == 1);
+}
+
+void testNoWeldingWithinCell() {
+	std::vector<Model::Vertex> vertices;
+	VertexWelder welder{ vertices, 4, 0.01f };
+
+	// opposite corners of one cell are further apart than epsilon
+	uint32_t a = welder.weld(makeVertex({ 0.0001f, 0.0001f, 0.0001f }));
+	uint32_t b = welder.weld(makeVertex({ 0.0099f, 0.0099f, 0.0099f }));
+
+	CHECK(a != b);
+	CHECK(vertices.size() == 2);
+
+	// both are found again afterwards
+	CHECK(welder.weld(makeVertex({ 0.0001f, 0.0001f, 0.0002f })) == a);
+	CHECK(welder.weld(makeVertex({ 0.0099f, 0.0098f, 0.0099f })) == b);
+}
+
+void testOtherAttributesKeepVerticesApart() {
+	std::vector<Model::Vertex> vertices;
+	VertexWelder welder{ vertices, 4, 0.01f };
+
+	Model::Vertex a = makeVertex({ 1.0f, 1.0f, 1.0f });
+	Model::Vertex b = makeVertex({ 1.001f, 1.0f, 1.0f });
+	b.uv = { 1.0f, 0.0f };
+
+	CHECK(welder.weld(a) != welder.weld(b));
+}
+
+void testManyVertices() {
+	std::vector<Model::Vertex> vertices;
+	VertexWelder welder{ vertices, 16, 0.001f };
+
+	// grows well past the initial capacity, every vertex is found again
+	std::vector<uint32_t> indices;
+
+	for (int i = 0; i < 10000; i++) {
+		indices.push_back(welder.weld(makeVertex({ i * 0.01f, 0.0f, 0.0f })));
+	}
+
+	CHECK(vertices.size() == 10000);
+
+	for (int i = 0; i < 10000; i++) {
+		CHECK(welder.weld(makeVertex({ i * 0.01f + 0.0002f, 0.0f, 0.0f })) == indices[i]);
+	}
+}
+
+}
+
+int main() {
+	testExactWelding();
+	testWeldingAcrossCells();
+	testNoWeldingWithinCell();
+	testOtherAttributesKeepVerticesApart();
+	testManyVertices();
+
+	return test::finish("VertexWelderTests");
+}
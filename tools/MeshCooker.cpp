@@ -0,0 +1,49 @@
+#include "renderer/MeshCache.hpp"
+
+#include "Core/Logger.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+// Pre-bakes the binary mesh cache for every OBJ file in a directory (default: assets/models)
+int main(int argc, char** argv) {
+    std::filesystem::current_path(PROJ_DIR);
+
+    std::filesystem::path directory = argc > 1 ? argv[1] : "assets/models";
+
+    if (!std::filesystem::is_directory(directory)) {
+        SFATAL("Not a directory: ", directory.string());
+        return EXIT_FAILURE;
+    }
+
+    int cooked = 0;
+    int failed = 0;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".obj") continue;
+
+        std::string filepath = entry.path().string();
+
+        try {
+            stl::Model::Data data{};
+            data.loadObj(filepath);
+
+            if (!stl::MeshCache::store(filepath, data)) {
+                throw std::runtime_error("Failed to write " + stl::MeshCache::getCachePath(filepath));
+            }
+
+            std::cout << filepath << ": " << data.vertices.size() << " vertices, " << data.indices.size() << " indices\n";
+            cooked++;
+        } catch (const std::exception& e) {
+            SERROR(filepath, ": ", e.what());
+            failed++;
+        }
+    }
+
+    std::cout << "Cooked " << cooked << " meshes, " << failed << " failed\n";
+
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}